@@ -2,6 +2,7 @@
 #define __DEFINES__
 
 #include <algorithm>
+#include <cstring>
 
 #include "IntegralTypes.h"
 #include "FloatingTypes.h"
@@ -49,6 +50,30 @@ inline u64 hashFNV1(const u8 (&rByteArray)[N]) {
 	return uHash;
 }
 
+// A hash of uByteCount bytes, taken a whole 64-bit word at a time where it can be, and chained from uHash. Each step is a
+// bijection of the hash for a given word, so any single changed word changes the result, and the shift folds each
+// product's high bits back down, so flips of the top bits of two words no longer cancel out. It's no FNV-1, so its
+// hashes are only ever comparable with its own
+inline u64 hashWords64(const void* pData, u64 uByteCount, u64 uHash = 0xCBF29CE484222325ull) {
+	const u8* pBytes = static_cast<const u8*>(pData);
+	u64 uByteIndex = 0;
+
+	for (; uByteIndex + sizeof(u64) <= uByteCount; uByteIndex += sizeof(u64)) {
+		u64 uWord;
+
+		std::memcpy(&uWord, pBytes + uByteIndex, sizeof(u64));
+		uHash = (uHash ^ uWord) * 0x100000001B3ull;
+		uHash ^= uHash >> 32;
+	}
+
+	for (; uByteIndex < uByteCount; ++uByteIndex) {
+		uHash = (uHash ^ pBytes[uByteIndex]) * 0x100000001B3ull;
+		uHash ^= uHash >> 32;
+	}
+
+	return uHash;
+}
+
 template<typename _BigType, typename _SmallType>
 constexpr inline _BigType pack(_SmallType valA, _SmallType valB) {
 	static_assert(sizeof(_BigType) == sizeof(_SmallType) << 1);
@@ -0,0 +1,177 @@
+#include "DeflateStream.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <zlib.h>
+
+CDeflateStream::CDeflateStream(const std::string& rFileName, s32 sLevel, u64 uBlockSize, u32 uMaxQueuedBlockCount) :
+	std::ostream(static_cast<std::streambuf*>(this)),
+	m_sLevel(sLevel),
+	m_uBlockSize(uBlockSize),
+	m_uMaxQueuedBlockCount(std::max(uMaxQueuedBlockCount, 1u)),
+	m_Block(uBlockSize),
+	m_bIsClosing(false),
+	m_bHasFailed(false),
+	m_dWaitSeconds(0.0) {
+
+	// An invalid level is refused before the file is opened, so it can't leave an empty file behind
+	if (sLevel >= Z_DEFAULT_COMPRESSION && sLevel <= Z_BEST_COMPRESSION) {
+		m_File.open(rFileName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+	}
+
+	if (!m_File.is_open()) {
+		m_bHasFailed = true;
+		setstate(std::ios_base::badbit);
+
+		return;
+	}
+
+	setp(m_Block.data(), m_Block.data() + m_Block.size());
+	m_Thread = std::thread(&CDeflateStream::Deflate, this);
+}
+
+CDeflateStream::~CDeflateStream() {
+	Close();
+}
+
+// Deflates what's left, finishes the file, and returns whether all of it was written
+bool CDeflateStream::Close() {
+	if (!m_Thread.joinable()) {
+		return !m_bHasFailed;
+	}
+
+	QueueBlock();
+	setp(nullptr, nullptr);
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_bIsClosing = true;
+	}
+
+	m_QueueChanged.notify_all();
+	m_Thread.join();
+	m_File.close();
+	m_bHasFailed |= m_File.fail();
+
+	if (m_bHasFailed) {
+		setstate(std::ios_base::badbit);
+	}
+
+	return !m_bHasFailed;
+}
+
+// Runs on m_Thread until the stream is closed and every queued block is deflated
+void CDeflateStream::Deflate() {
+	z_stream zStream = {};
+	std::vector<c8> output(m_uBlockSize);
+	std::vector<c8> block;
+
+	// 16 more window bits asks for a gzip header and trailer rather than a zlib one
+	bool bHasFailed = deflateInit2(&zStream, m_sLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK;
+	bool bIsLastBlock = false;
+
+	while (!bIsLastBlock) {
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+
+			if (block.capacity()) {
+				m_FreeBlocks.push_back(std::move(block));
+			}
+
+			m_QueueChanged.wait(lock, [this] { return m_QueuedBlocks.size() || m_bIsClosing; });
+
+			if (m_QueuedBlocks.size()) {
+				block = std::move(m_QueuedBlocks.front());
+				m_QueuedBlocks.pop_front();
+			} else {
+				block = {};
+			}
+
+			bIsLastBlock = m_bIsClosing && m_QueuedBlocks.empty();
+		}
+
+		m_QueueChanged.notify_all();
+
+		// Blocks are still taken after a failure, so the writer never waits on a queue that won't drain
+		if (bHasFailed) {
+			continue;
+		}
+
+		zStream.next_in = reinterpret_cast<Bytef*>(block.data());
+		zStream.avail_in = block.size();
+
+		do {
+			zStream.next_out = reinterpret_cast<Bytef*>(output.data());
+			zStream.avail_out = output.size();
+
+			if (deflate(&zStream, bIsLastBlock ? Z_FINISH : Z_NO_FLUSH) == Z_STREAM_ERROR) {
+				bHasFailed = true;
+
+				break;
+			}
+
+			m_File.write(output.data(), output.size() - zStream.avail_out);
+		} while (!zStream.avail_out);
+	}
+
+	deflateEnd(&zStream);
+	m_bHasFailed = bHasFailed || m_File.fail();
+}
+
+// Hands the block being written to the deflating thread, and starts another
+void CDeflateStream::QueueBlock() {
+	if (pptr() == pbase()) {
+		return;
+	}
+
+	m_Block.resize(pptr() - pbase());
+
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		if (m_QueuedBlocks.size() >= m_uMaxQueuedBlockCount) {
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			m_QueueChanged.wait(lock, [this] { return m_QueuedBlocks.size() < m_uMaxQueuedBlockCount; });
+			m_dWaitSeconds += std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+		}
+
+		m_QueuedBlocks.push_back(std::move(m_Block));
+
+		if (m_FreeBlocks.size()) {
+			m_Block = std::move(m_FreeBlocks.back());
+			m_FreeBlocks.pop_back();
+		} else {
+			m_Block = {};
+		}
+	}
+
+	m_QueueChanged.notify_all();
+	m_Block.resize(m_uBlockSize);
+	setp(m_Block.data(), m_Block.data() + m_Block.size());
+}
+
+std::streambuf::int_type CDeflateStream::overflow(std::streambuf::int_type c) {
+	if (!m_Thread.joinable()) {
+		return std::streambuf::traits_type::eof();
+	}
+
+	QueueBlock();
+
+	if (!std::streambuf::traits_type::eq_int_type(c, std::streambuf::traits_type::eof())) {
+		*pptr() = std::streambuf::traits_type::to_char_type(c);
+		pbump(1);
+	}
+
+	return std::streambuf::traits_type::not_eof(c);
+}
+
+int CDeflateStream::sync() {
+	if (m_Thread.joinable()) {
+		QueueBlock();
+	}
+
+	return 0;
+}
\ No newline at end of file
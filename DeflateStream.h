@@ -0,0 +1,56 @@
+#ifndef __DEFLATE_STREAM__
+#define __DEFLATE_STREAM__
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Defines.h"
+
+// An std::ostream that writes a gzip file, as .svgz files are. Text is gathered into blocks, which are deflated and
+// written on a thread of their own, fed through a queue of at most uMaxQueuedBlockCount blocks, so a writer only waits on
+// the compression once it's fallen that far behind. The file is finished by Close(), or else by the destructor, though
+// only Close() reports whether it was all written. A level outside zlib's -1 (default) to 9 leaves the stream unopened.
+class CDeflateStream : private std::streambuf, public std::ostream {
+// Functions
+public:
+	CDeflateStream(const std::string& rFileName, s32 sLevel = 6, u64 uBlockSize = 1 << 20, u32 uMaxQueuedBlockCount = 4);
+	~CDeflateStream();
+
+	CDeflateStream(const CDeflateStream&) = delete;
+	CDeflateStream& operator=(const CDeflateStream&) = delete;
+
+	bool	Close			();
+	f64		GetWaitSeconds	()				const { return m_dWaitSeconds; }
+	bool	IsOpen			()				const { return m_File.is_open(); }
+private:
+	void	Deflate		();
+	void	QueueBlock	();
+
+	std::streambuf::int_type	overflow	(std::streambuf::int_type c)	override;
+	int							sync		()								override;
+
+// Variables
+private:
+	std::ofstream					m_File;
+	s32								m_sLevel;			// zlib's, from 0 (stored) to 9 (smallest), or -1 for its default
+	u64								m_uBlockSize;
+	u32								m_uMaxQueuedBlockCount;
+	std::vector<c8>					m_Block;			// Being written
+	std::deque<std::vector<c8>>		m_QueuedBlocks;
+	std::vector<std::vector<c8>>	m_FreeBlocks;		// Deflated, kept for reuse
+	std::mutex						m_Mutex;			// Guards the queue, free blocks and m_bIsClosing
+	std::condition_variable			m_QueueChanged;
+	bool							m_bIsClosing;
+	bool							m_bHasFailed;		// Written by the deflating thread until it's joined
+	f64								m_dWaitSeconds;		// Spent waiting on a full queue
+	std::thread						m_Thread;
+};
+
+#endif // __DEFLATE_STREAM__
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "FaceList.h"
+
+#include "GeometryFile.h"
+#include "Parallel.h"
+
+CFaceList::CFaceList() :
+	m_Offsets(1, 0) {}
+
+// Appends the offsets and then the indices, as CopyArrays() reads them back
+void CFaceList::AppendArrays(std::vector<std::span<const u8>>& rArrays) const {
+	rArrays.push_back(CGeometryFile::GetBytes(m_Offsets));
+	rArrays.push_back(CGeometryFile::GetBytes(m_Indices));
+}
+
+bool CFaceList::CopyArrays(const CGeometryFile& rFile, u32 uFirstArray) {
+	return
+		rFile.CopyArray(uFirstArray, m_Offsets) &&
+		rFile.CopyArray(uFirstArray + 1, m_Indices) &&
+		m_Offsets.size() && !m_Offsets.front() && m_Offsets.back() == m_Indices.size();
+}
+
+// Of the allocated storage only, whether on the heap or mapped, like a std::vector's capacity
+u64 CFaceList::GetMemoryUsage() const {
+	return m_Offsets.capacity() * sizeof(u64) + m_Indices.capacity() * sizeof(u32);
+}
+
+// Replaces the list with uCopyCount copies of itself, copy c's vertex indices being raised by c * uVertStride
+void CFaceList::Repeat(u64 uCopyCount, u32 uVertStride) {
+	const u64 uFaceCount = size();
+	const u64 uIndexCount = m_Indices.size();
+
+	// The last copy's indices are offset by this much, and would silently wrap past a u32
+	if (uCopyCount && uVertStride > u32_MAX / uCopyCount) {
+		throw std::length_error("CFaceList::Repeat: the copies' vertex count overflows a u32 index");
+	}
+
+	m_Offsets.resize(uFaceCount * uCopyCount + 1);
+	m_Indices.resize(uIndexCount * uCopyCount);
+
+	// Copy 0 is the original, which every other copy reads but none writes
+	parallelFor(std::max<u64>(uCopyCount, 1) - 1, [&](u64 uBegin, u64 uEnd) {
+		for (u64 uCopy = uBegin + 1; uCopy <= uEnd; ++uCopy) {
+			const u64 uIndexOffset = uCopy * uIndexCount;
+			const u32 uVertOffset = uCopy * uVertStride;
+			u64* pDstOffsets = m_Offsets.data() + uCopy * uFaceCount;
+			u32* pDstIndices = m_Indices.data() + uIndexOffset;
+
+			for (u64 f = 1; f <= uFaceCount; ++f) {
+				pDstOffsets[f] = m_Offsets[f] + uIndexOffset;
+			}
+
+			for (u64 i = 0; i < uIndexCount; ++i) {
+				pDstIndices[i] = m_Indices[i] + uVertOffset;
+			}
+		}
+	}, std::max<u64>((1 << 14) / std::max<u64>(uIndexCount, 1), 1));
+}
+
+// Sides are laid out as the vertex indices are, side i running from vertex index i to the next one around its face, so
+// face f's sides are rSideEdges[GetIndexOffset(f), GetIndexOffset(f + 1)). A side without an edge along it gets edge 0
+void CFaceList::PopulateSideEdges(std::span<const std::pair<u32, u32>> edges, CMappedVector<u32>& rSideEdges) const {
+	// Sorted by vertex pair key, then edge, so a binary search finds the first edge between two vertices without the
+	// scattered buckets of a hash map
+	CMappedVector<std::pair<u64, u32>> inverseEdges(edges.size());
+
+	for (u64 e = 0; e < edges.size(); ++e) {
+		inverseEdges[e] = std::pair<u64, u32>(static_cast<u64>(edges[e].first) + (static_cast<u64>(edges[e].second) << 32), e);
+	}
+
+	std::sort(inverseEdges.begin(), inverseEdges.end());
+	rSideEdges.resize(m_Indices.size());
+
+	parallelFor(size(), [this, &inverseEdges, &rSideEdges](u64 uBegin, u64 uEnd) {
+		for (u64 f = uBegin; f < uEnd; ++f) {
+			for (u64 i = m_Offsets[f]; i < m_Offsets[f + 1]; ++i) {
+				u32 uVertIndex1 = m_Indices[i];
+				u32 uVertIndex2 = m_Indices[i + 1 < m_Offsets[f + 1] ? i + 1 : m_Offsets[f]];
+
+				if (uVertIndex1 > uVertIndex2) {
+					std::swap(uVertIndex1, uVertIndex2);
+				}
+
+				const u64 uEdgeKey = static_cast<u64>(uVertIndex1) + (static_cast<u64>(uVertIndex2) << 32);
+				const CMappedVector<std::pair<u64, u32>>::const_iterator edgeIter = std::lower_bound(inverseEdges.begin(), inverseEdges.end(), std::pair<u64, u32>(uEdgeKey, 0));
+
+				rSideEdges[i] = edgeIter != inverseEdges.end() && edgeIter->first == uEdgeKey ? edgeIter->second : 0;
+			}
+		}
+	});
+}
+
+void CFaceList::Reserve(u64 uFaceCount, u64 uIndexCount) {
+	m_Offsets.reserve(uFaceCount + 1);
+	m_Indices.reserve(uIndexCount);
+}
+
+bool CFaceList::operator==(const CFaceList& rFaceList) const {
+	return m_Offsets == rFaceList.m_Offsets && m_Indices == rFaceList.m_Indices;
+}
\ No newline at end of file
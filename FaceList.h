@@ -0,0 +1,52 @@
+#ifndef __FACE_LIST__
+#define __FACE_LIST__
+
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Defines.h"
+
+#include "MappedAllocator.h"
+
+// Forward Declarations
+class CGeometryFile;
+
+// Faces in compressed sparse row form: face f's vertex indices are m_Indices[m_Offsets[f], m_Offsets[f + 1]), so all of
+// them share two allocations rather than taking one each
+class CFaceList {
+// Functions
+public:
+	CFaceList();
+
+	void	AppendArrays	(std::vector<std::span<const u8>>& rArrays)	const;
+	bool	CopyArrays		(const CGeometryFile& rFile, u32 uFirstArray);
+	u64		GetIndexCount	()								const { return m_Indices.size(); }
+	u64		GetIndexOffset	(u64 uFace)						const { return m_Offsets[uFace]; }
+	u64		GetMemoryUsage	()								const;
+	void	PopulateSideEdges	(std::span<const std::pair<u32, u32>> edges, CMappedVector<u32>& rSideEdges)	const;
+	void	Repeat			(u64 uCopyCount, u32 uVertStride);
+	void	Reserve			(u64 uFaceCount, u64 uIndexCount);
+	u64		size			()								const { return m_Offsets.size() - 1; }
+
+	// Appends a face with the vertex indices in [begin, end)
+	template<typename _Iter>
+	void	PushBack		(_Iter begin, _Iter end);
+
+	std::span<const u32>	operator[]	(u64 uFace)						const { return { m_Indices.data() + m_Offsets[uFace], m_Indices.data() + m_Offsets[uFace + 1] }; }
+	std::span<u32>			operator[]	(u64 uFace)								{ return { m_Indices.data() + m_Offsets[uFace], m_Indices.data() + m_Offsets[uFace + 1] }; }
+	bool					operator==	(const CFaceList& rFaceList)	const;
+
+// Variables
+private:
+	CMappedVector<u64>	m_Offsets;	// One more than the face count, starting at 0
+	CMappedVector<u32>	m_Indices;
+};
+
+template<typename _Iter>
+void CFaceList::PushBack(_Iter begin, _Iter end) {
+	m_Indices.insert(m_Indices.end(), begin, end);
+	m_Offsets.push_back(m_Indices.size());
+}
+
+#endif // __FACE_LIST__
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "FaceStream.h"
+
+#include "Extrema.h"
+#include "PhiFractal.h"
+#include "PhiVector3.h"
+#include "RadixSort.h"
+
+const u32 g_kuFaceLevel = u32_MAX;
+
+CFaceStream::CFaceStream(const CPhiFractal& rPhiFractal, CPolyhedron::EPerspective ePerspective, bool bIsFrontToBack) :
+	m_rPhiFractal(rPhiFractal),
+	m_ePerspective(ePerspective),
+	m_bIsFrontToBack(bIsFrontToBack),
+	m_uReleasedSlot(u32_MAX) {
+
+	const CPhiPolyhedron& rBase = rPhiFractal.GetBase();
+	u32 uRotatedAxis;
+	f64 dCos;
+	f64 dSin;
+
+	CPolyhedron::ComputeViewRotation(ePerspective, uRotatedAxis, dCos, dSin);
+
+	// Only bounds depths, so it needn't round exactly as CPolyhedron::ProjectVertices does
+	const auto project = [uRotatedAxis, dCos, dSin](const CPhiVector3& rVertex) {
+		std::array<f64, 3> coordinates = { rVertex.x.GetF64(), rVertex.y.GetF64(), rVertex.z.GetF64() };
+		const f64 dU = coordinates[uRotatedAxis];
+		const f64 dZ = coordinates[2];
+
+		coordinates[uRotatedAxis] = dCos * dU + dSin * dZ;
+		coordinates[2] = -dSin * dU + dCos * dZ;
+
+		return coordinates;
+	};
+	const auto computeExtent = [](const std::vector<std::array<f64, 3>>& rVertices, f64& rdMinZ, f64& rdMaxZ, f64& rdMaxMagnitude) {
+		rdMinZ = rVertices[0][2];
+		rdMaxZ = rVertices[0][2];
+		rdMaxMagnitude = 0.0;
+
+		for (const std::array<f64, 3>& rVertex : rVertices) {
+			minAssign(rdMinZ, rVertex[2]);
+			maxAssign(rdMaxZ, rVertex[2]);
+			maxAssign(rdMaxMagnitude, std::max({ std::abs(rVertex[0]), std::abs(rVertex[1]), std::abs(rVertex[2]) }));
+		}
+	};
+
+	for (const CPhiVector3& rVertex : rBase.m_Vertices) {
+		m_BaseVertices.push_back(project(rVertex));
+	}
+
+	f64 dMinZ;
+	f64 dMaxZ;
+	f64 dMaxMagnitude;
+
+	computeExtent(m_BaseVertices, dMinZ, dMaxZ, dMaxMagnitude);
+	m_SubtreeMinZ.push_back(dMinZ);
+	m_SubtreeMaxZ.push_back(dMaxZ);
+	m_SubtreeCopyCounts.push_back(1);
+	m_dDepthMargin = dMaxMagnitude;
+
+	for (u32 l = 0; l < rPhiFractal.GetLevelCount(); ++l) {
+		m_LevelTranslations.emplace_back();
+
+		for (const CPhiVector3& rTranslation : rPhiFractal.GetLevelTranslations(l)) {
+			m_LevelTranslations[l].push_back(project(rTranslation));
+		}
+
+		computeExtent(m_LevelTranslations[l], dMinZ, dMaxZ, dMaxMagnitude);
+		m_SubtreeMinZ.push_back(m_SubtreeMinZ[l] + dMinZ);
+		m_SubtreeMaxZ.push_back(m_SubtreeMaxZ[l] + dMaxZ);
+		m_SubtreeCopyCounts.push_back(m_SubtreeCopyCounts[l] * rBase.m_Vertices.size());
+		m_dDepthMargin += dMaxMagnitude;
+	}
+
+	// A face's f32 depth strays from its exact depth by a few ulps of the largest coordinate, far less than 2^-16 of it
+	m_dDepthMargin *= 0x1p-16;
+	m_PhiCopy.m_Vertices.resize(rBase.m_Vertices.size());
+
+	// Every copy shares the base's local vertex indices, so the base's side edges are every copy's
+	rBase.m_Faces.PopulateSideEdges(rBase.m_Edges, m_SideEdges);
+	m_BaseEdgeFaceCounts.assign(rBase.m_Edges.size(), 0);
+	m_BaseVertFaceCounts.assign(rBase.m_Vertices.size(), 0);
+
+	for (u64 f = 0; f < rBase.m_Faces.size(); ++f) {
+		const std::span<const u32> face = rBase.m_Faces[f];
+		const u64 uOffset = rBase.m_Faces.GetIndexOffset(f);
+
+		for (u32 fv = 0; fv < face.size(); ++fv) {
+			++m_BaseEdgeFaceCounts[m_SideEdges[uOffset + fv]];
+			++m_BaseVertFaceCounts[face[fv]];
+		}
+	}
+
+	PushSubtree(rPhiFractal.GetLevelCount(), 0, 0.0);
+}
+
+// Flags the sides of rFace whose edge or first vertex no face painted after it touches: back to front, the ones it's the
+// copy's last face to touch, and front to back, the ones it's the first. As in CPolyhedron::PopulateSideFlags, writing
+// only those writes each edge and vertex once, on top of every face around it
+void CFaceStream::ClaimSides(const SFace& rFace, std::vector<u8>& rSideFlags) {
+	SCopySlot& rSlot = m_CopySlots[rFace.m_uSlot];
+	const CFaceList& rFaces = m_rPhiFractal.GetBase().m_Faces;
+	const std::span<const u32> face = rFaces[rFace.m_uFace];
+	const u64 uOffset = rFaces.GetIndexOffset(rFace.m_uFace);
+	const auto claim = [this](u8& rFaceCount) {
+		if (m_bIsFrontToBack) {
+			return !rFaceCount++;
+		}
+
+		return !--rFaceCount;
+	};
+
+	rSideFlags.assign(face.size(), 0);
+
+	for (u32 fv = 0; fv < face.size(); ++fv) {
+		if (claim(rSlot.m_EdgeFaceCounts[m_SideEdges[uOffset + fv]])) {
+			rSideFlags[fv] |= CPolyhedron::SideEdge;
+		}
+
+		if (claim(rSlot.m_VertFaceCounts[face[fv]])) {
+			rSideFlags[fv] |= CPolyhedron::SideVert;
+		}
+	}
+}
+
+// Every combination of one translation per level and one base vertex is a vertex, so each extreme coordinate belongs to
+// the vertex made of every level's extreme. Those vertices are then projected exactly as the faces' vertices are
+CExtrema CFaceStream::ComputeExtrema() const {
+	const CPhiPolyhedron& rBase = m_rPhiFractal.GetBase();
+	CPhiPolyhedron extremeVertices;
+
+	for (u32 uAxis = 0; uAxis < 2; ++uAxis) {
+		for (f64 dSign : { -1.0, 1.0 }) {
+			const auto findExtreme = [uAxis, dSign](const std::vector<std::array<f64, 3>>& rVertices) {
+				u32 uExtreme = 0;
+
+				for (u32 v = 1; v < rVertices.size(); ++v) {
+					if (dSign * rVertices[v][uAxis] > dSign * rVertices[uExtreme][uAxis]) {
+						uExtreme = v;
+					}
+				}
+
+				return uExtreme;
+			};
+			CPhiVector3 extremeVertex = rBase.m_Vertices[findExtreme(m_BaseVertices)];
+
+			for (u32 l = 0; l < m_LevelTranslations.size(); ++l) {
+				extremeVertex += m_rPhiFractal.GetLevelTranslations(l)[findExtreme(m_LevelTranslations[l])];
+			}
+
+			extremeVertices.m_Vertices.push_back(extremeVertex);
+		}
+	}
+
+	CPolyhedron polyhedron;
+	CExtrema extrema;
+
+	polyhedron.ProjectVertices(extremeVertices, m_ePerspective);
+
+	for (const CVector3& rVertex : polyhedron.m_Vertices) {
+		extrema.ReEvaluate(rVertex);
+	}
+
+	return extrema;
+}
+
+bool CFaceStream::Next(SFace& rFace) {
+	if (m_uReleasedSlot != u32_MAX) {
+		m_FreeSlots.push_back(m_uReleasedSlot);
+		m_uReleasedSlot = u32_MAX;
+	}
+
+	while (m_Entries.size()) {
+		const SEntry entry = m_Entries.top();
+
+		m_Entries.pop();
+
+		if (entry.m_uLevel == g_kuFaceLevel) {
+			SCopySlot& rSlot = m_CopySlots[entry.m_uSlot];
+
+			rFace.m_pCopy = &rSlot.m_Polyhedron;
+			rFace.m_pAttributes = &rSlot.m_FaceAttributes[entry.m_uFace];
+			rFace.m_uFace = entry.m_uFace;
+			rFace.m_uSlot = entry.m_uSlot;
+
+			if (!--rSlot.m_uPendingFaceCount) {
+				m_uReleasedSlot = entry.m_uSlot;
+			}
+
+			return true;
+		}
+
+		if (!entry.m_uLevel) {
+			PushCopy(entry.m_uCopy);
+
+			continue;
+		}
+
+		// Split the subtree by its most significant free digit
+		const u32 uChildLevel = entry.m_uLevel - 1;
+
+		for (u32 d = 0; d < m_LevelTranslations[uChildLevel].size(); ++d) {
+			PushSubtree(uChildLevel, entry.m_uCopy + d * m_SubtreeCopyCounts[uChildLevel], entry.m_dZ + m_LevelTranslations[uChildLevel][d][2]);
+		}
+	}
+
+	return false;
+}
+
+void CFaceStream::PushCopy(u64 uCopy) {
+	const CPhiPolyhedron& rBase = m_rPhiFractal.GetBase();
+	u32 uSlot;
+
+	if (m_FreeSlots.size()) {
+		uSlot = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+	} else {
+		uSlot = m_CopySlots.size();
+		m_CopySlots.push_back({ CPolyhedron(rBase, m_ePerspective), {}, {}, {}, 0 });
+	}
+
+	SCopySlot& rSlot = m_CopySlots[uSlot];
+	const CPhiVector3 translation = m_rPhiFractal.GetCopyTranslation(uCopy);
+
+	for (u32 v = 0; v < rBase.m_Vertices.size(); ++v) {
+		m_PhiCopy.m_Vertices[v] = rBase.m_Vertices[v] + translation;
+	}
+
+	rSlot.m_Polyhedron.ProjectVertices(m_PhiCopy, m_ePerspective);
+	m_rPhiFractal.PopulateCopyLevels(uCopy, rSlot.m_Polyhedron.m_VertexLevels, rSlot.m_Polyhedron.m_EdgeLevels, rSlot.m_Polyhedron.m_FaceLevels);
+	rSlot.m_Polyhedron.PopulateFaceAttributes(rSlot.m_FaceAttributes);
+	rSlot.m_uPendingFaceCount = rBase.m_Faces.size();
+
+	if (m_bIsFrontToBack) {
+		rSlot.m_EdgeFaceCounts.assign(rBase.m_Edges.size(), 0);
+		rSlot.m_VertFaceCounts.assign(rBase.m_Vertices.size(), 0);
+	} else {
+		rSlot.m_EdgeFaceCounts = m_BaseEdgeFaceCounts;
+		rSlot.m_VertFaceCounts = m_BaseVertFaceCounts;
+	}
+
+	for (u32 f = 0; f < rBase.m_Faces.size(); ++f) {
+		const u32 uKey = computeSortableKey(rSlot.m_FaceAttributes[f].m_fDepth);
+		const u64 uOrder = uCopy * rBase.m_Faces.size() + f;
+
+		m_Entries.push({ m_bIsFrontToBack ? ~uKey : uKey, m_bIsFrontToBack ? ~uOrder : uOrder, uCopy, 0.0, g_kuFaceLevel, uSlot, f });
+	}
+}
+
+void CFaceStream::PushSubtree(u32 uLevel, u64 uCopy, f64 dZ) {
+	const u64 uBaseFaceCount = m_rPhiFractal.GetBase().m_Faces.size();
+
+	if (m_bIsFrontToBack) {
+		const f32 fMaxDepth = static_cast<f32>(dZ + m_SubtreeMaxZ[uLevel] + m_dDepthMargin);
+		const u64 uLastFace = (uCopy + m_SubtreeCopyCounts[uLevel]) * uBaseFaceCount - 1;
+
+		m_Entries.push({ ~computeSortableKey(fMaxDepth), ~uLastFace, uCopy, dZ, uLevel, 0, 0 });
+	} else {
+		const f32 fMinDepth = static_cast<f32>(dZ + m_SubtreeMinZ[uLevel] - m_dDepthMargin);
+
+		m_Entries.push({ computeSortableKey(fMinDepth), uCopy * uBaseFaceCount, uCopy, dZ, uLevel, 0, 0 });
+	}
+}
+
+bool CFaceStream::SEntry::operator>(const SEntry& rEntry) const {
+	return m_uKey != rEntry.m_uKey ? m_uKey > rEntry.m_uKey : m_uOrder > rEntry.m_uOrder;
+}
\ No newline at end of file
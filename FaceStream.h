@@ -0,0 +1,87 @@
+#ifndef __FACE_STREAM__
+#define __FACE_STREAM__
+
+#include <array>
+#include <queue>
+#include <vector>
+
+#include "Defines.h"
+
+#include "MappedAllocator.h"
+#include "PhiPolyhedron.h"
+#include "Polyhedron.h"
+
+// Forward Declarations
+class CExtrema;
+class CPhiFractal;
+
+// Yields a fractal's projected faces one at a time, in the order a stable sort by depth would put them: increasing (back
+// to front) or decreasing (front to back). A subtree of the copy hierarchy is bounded in depth by its translation plus the
+// extent of the levels below it, so it's only expanded once the stream reaches that bound, and only the copies straddling
+// the current depth are ever projected and held in memory.
+class CFaceStream {
+// Structs
+public:
+	struct SFace {
+		const CPolyhedron*					m_pCopy;		// Valid until the next call to Next()
+		const CPolyhedron::SFaceAttributes*	m_pAttributes;
+		u32									m_uFace;		// Within m_pCopy
+		u32									m_uSlot;
+	};
+private:
+	// Either one face of a projected copy, or the subtree of every copy that shares uCopy's digits from m_uLevel up
+	struct SEntry {
+		u32	m_uKey;		// The sortable depth key, bounding those of the subtree's faces (inverted front to back)
+		u64	m_uOrder;	// The fractal face index, bounding those of the subtree's faces (inverted front to back)
+		u64	m_uCopy;	// The subtree's first copy, or the face's copy
+		f64	m_dZ;		// The subtree's translation along the view axis
+		u32	m_uLevel;	// Free digits in the subtree, or g_kuFaceLevel for a face
+		u32	m_uSlot;	// Of the face's copy
+		u32	m_uFace;	// Within the face's copy
+
+		bool operator>(const SEntry& rEntry) const;
+	};
+
+	struct SCopySlot {
+		CPolyhedron										m_Polyhedron;
+		CMappedVector<CPolyhedron::SFaceAttributes>	m_FaceAttributes;
+		std::vector<u8>									m_EdgeFaceCounts;	// Back to front, each one's unclaimed faces, and front to back, whether any has claimed it
+		std::vector<u8>									m_VertFaceCounts;
+		u32												m_uPendingFaceCount;
+	};
+
+// Functions
+public:
+	CFaceStream(const CPhiFractal& rPhiFractal, CPolyhedron::EPerspective ePerspective, bool bIsFrontToBack = false);
+
+	void						ClaimSides		(const SFace& rFace, std::vector<u8>& rSideFlags);
+	CExtrema					ComputeExtrema	()				const;
+	const CMappedVector<u32>&	GetSideEdges	()				const { return m_SideEdges; }
+	u32							GetSlotCount	()				const { return m_CopySlots.size(); }
+	bool						Next			(SFace& rFace);
+private:
+	void	PushCopy	(u64 uCopy);
+	void	PushSubtree	(u32 uLevel, u64 uCopy, f64 dZ);
+
+// Variables
+private:
+	const CPhiFractal&											m_rPhiFractal;
+	CPolyhedron::EPerspective									m_ePerspective;
+	bool														m_bIsFrontToBack;
+	std::vector<std::vector<std::array<f64, 3>>>				m_LevelTranslations;	// Projected, per level
+	std::vector<std::array<f64, 3>>								m_BaseVertices;			// Projected
+	std::vector<f64>											m_SubtreeMinZ;			// Per free digit count
+	std::vector<f64>											m_SubtreeMaxZ;
+	std::vector<u64>											m_SubtreeCopyCounts;
+	f64															m_dDepthMargin;
+	CMappedVector<u32>											m_SideEdges;			// Of the base's face sides
+	std::vector<u8>												m_BaseEdgeFaceCounts;
+	std::vector<u8>												m_BaseVertFaceCounts;
+	CPhiPolyhedron												m_PhiCopy;
+	std::vector<SCopySlot>										m_CopySlots;
+	std::vector<u32>											m_FreeSlots;
+	u32															m_uReleasedSlot;		// Freed by the next call to Next()
+	std::priority_queue<SEntry, std::vector<SEntry>, std::greater<SEntry>>	m_Entries;
+};
+
+#endif // __FACE_STREAM__
\ No newline at end of file
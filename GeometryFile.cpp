@@ -0,0 +1,155 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "GeometryFile.h"
+
+// "ICOSGEOM", read as a little-endian u64
+constexpr const u64 g_kuGeometryFileMagic = 0x4D4F4547534F4349ull;
+
+CGeometryFile::CGeometryFile() :
+	m_pMapping(nullptr),
+	m_uMappingSize(0),
+	m_pHeader(nullptr) {}
+
+CGeometryFile::~CGeometryFile() {
+	Unmap();
+}
+
+bool CGeometryFile::Map(const std::string& rFileName, u64 uFormat, u64 uKey) {
+	Unmap();
+
+	const s32 sFile = open(rFileName.c_str(), O_RDONLY);
+
+	if (sFile < 0) {
+		return false;
+	}
+
+	struct stat fileStat;
+	void* pMapping = fstat(sFile, &fileStat) || static_cast<u64>(fileStat.st_size) < sizeof(SHeader) ?
+		MAP_FAILED :
+		mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, sFile, 0);
+
+	close(sFile);
+
+	if (pMapping == MAP_FAILED) {
+		return false;
+	}
+
+	// Both the checksum pass and the copies out of the mapping read it front to back
+	madvise(pMapping, fileStat.st_size, MADV_SEQUENTIAL);
+	m_pMapping = static_cast<const u8*>(pMapping);
+	m_uMappingSize = fileStat.st_size;
+	m_pHeader = static_cast<const SHeader*>(pMapping);
+
+	if (m_pHeader->m_uMagic != g_kuGeometryFileMagic ||
+		m_pHeader->m_uFormat != uFormat ||
+		m_pHeader->m_uKey != uKey ||
+		m_pHeader->m_uArrayCount > std::size(m_pHeader->m_auArrayByteCounts)) {
+
+		Unmap();
+
+		return false;
+	}
+
+	u64 uOffset = sizeof(SHeader);
+	u64 uChecksum = crc32_z(0, nullptr, 0);
+
+	for (u32 a = 0; a < m_pHeader->m_uArrayCount; ++a) {
+		const u64 uByteCount = m_pHeader->m_auArrayByteCounts[a];
+
+		if (uByteCount > m_uMappingSize - uOffset || ComputePaddedSize(uByteCount) > m_uMappingSize - uOffset) {
+			Unmap();
+
+			return false;
+		}
+
+		m_ArrayOffsets.push_back(uOffset);
+		uChecksum = crc32_z(uChecksum, m_pMapping + uOffset, uByteCount);
+		uChecksum = crc32_z(uChecksum, m_pMapping + uOffset + uByteCount, ComputePaddedSize(uByteCount) - uByteCount);
+		uOffset += ComputePaddedSize(uByteCount);
+	}
+
+	if (uChecksum != m_pHeader->m_uChecksum) {
+		Unmap();
+
+		return false;
+	}
+
+	return true;
+}
+
+void CGeometryFile::Unmap() {
+	if (m_pMapping) {
+		munmap(const_cast<u8*>(m_pMapping), m_uMappingSize);
+	}
+
+	m_pMapping = nullptr;
+	m_uMappingSize = 0;
+	m_ArrayOffsets.clear();
+	m_pHeader = nullptr;
+}
+
+// Writes to a temporary file first, then renames it into place, so an interrupted save never leaves a partial file
+// under rFileName
+bool CGeometryFile::Save(const std::string& rFileName, u64 uFormat, u64 uKey, const std::vector<std::span<const u8>>& rArrays) {
+	SHeader header = {};
+
+	if (rArrays.size() > std::size(header.m_auArrayByteCounts)) {
+		return false;
+	}
+
+	static const u8 sauPadding[64] = {};
+	u64 uChecksum = crc32_z(0, nullptr, 0);
+
+	header.m_uMagic = g_kuGeometryFileMagic;
+	header.m_uFormat = uFormat;
+	header.m_uKey = uKey;
+	header.m_uArrayCount = rArrays.size();
+
+	for (u32 a = 0; a < rArrays.size(); ++a) {
+		header.m_auArrayByteCounts[a] = rArrays[a].size();
+		uChecksum = crc32_z(uChecksum, rArrays[a].data(), rArrays[a].size());
+		uChecksum = crc32_z(uChecksum, sauPadding, ComputePaddedSize(rArrays[a].size()) - rArrays[a].size());
+	}
+
+	header.m_uChecksum = uChecksum;
+
+	const std::filesystem::path filePath(rFileName);
+	const std::string tempFileName = rFileName + ".tmp";
+	std::error_code errorCode;
+
+	if (filePath.has_parent_path()) {
+		std::filesystem::create_directories(filePath.parent_path(), errorCode);
+	}
+
+	std::ofstream file(tempFileName.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	file.write(static_cast<const char*>(static_cast<const void*>(&header)), sizeof(header));
+
+	for (const std::span<const u8>& rArray : rArrays) {
+		file.write(static_cast<const char*>(static_cast<const void*>(rArray.data())), rArray.size());
+		file.write(static_cast<const char*>(static_cast<const void*>(sauPadding)), ComputePaddedSize(rArray.size()) - rArray.size());
+	}
+
+	file.close();
+
+	if (!file || std::rename(tempFileName.c_str(), rFileName.c_str())) {
+		std::remove(tempFileName.c_str());
+
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef __GEOMETRY_FILE__
+#define __GEOMETRY_FILE__
+
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Defines.h"
+
+// A binary file of raw arrays, laid out so that it can be mapped and read in place: a fixed-size header, then each array
+// in turn, each starting on a 64-byte boundary. The header holds a checksum of everything after it, plus a key naming
+// what the arrays were generated from, so a truncated, corrupted or stale file is rejected rather than loaded.
+class CGeometryFile {
+// Structs
+private:
+	struct SHeader {
+		u64	m_uMagic;
+		u64	m_uFormat;		// What the arrays are, and the version of their layout
+		u64	m_uKey;
+		u64	m_uChecksum;	// zlib's CRC-32, chained over each array and then its padding
+		u64	m_uArrayCount;
+		u64	m_auArrayByteCounts[11];
+	};
+
+// Functions
+public:
+	CGeometryFile();
+	~CGeometryFile();
+
+	CGeometryFile(const CGeometryFile&) = delete;
+	CGeometryFile& operator=(const CGeometryFile&) = delete;
+
+	bool	Map	(const std::string& rFileName, u64 uFormat, u64 uKey);
+	void	Unmap	();
+
+	// Copies array uArray into rVector, failing if its size isn't a multiple of the element size
+	template<typename _Vector>
+	bool	CopyArray	(u32 uArray, _Vector& rVector)	const;
+
+	static	bool	Save	(const std::string& rFileName, u64 uFormat, u64 uKey, const std::vector<std::span<const u8>>& rArrays);
+
+	// The bytes of an array, for passing to Save()
+	template<typename _Vector>
+	static	std::span<const u8>	GetBytes	(const _Vector& rVector);
+private:
+	static	u64	ComputePaddedSize	(u64 uByteCount) { return (uByteCount + 63) & ~63ull; }
+
+// Variables
+private:
+	const u8*			m_pMapping;
+	u64					m_uMappingSize;
+	std::vector<u64>	m_ArrayOffsets;
+	const SHeader*		m_pHeader;
+};
+
+template<typename _Vector>
+bool CGeometryFile::CopyArray(u32 uArray, _Vector& rVector) const {
+	typedef typename _Vector::value_type Value;
+
+	if (uArray >= m_ArrayOffsets.size() || m_pHeader->m_auArrayByteCounts[uArray] % sizeof(Value)) {
+		return false;
+	}
+
+	const u64 uByteCount = m_pHeader->m_auArrayByteCounts[uArray];
+
+	rVector.resize(uByteCount / sizeof(Value));
+	std::memcpy(static_cast<void*>(rVector.data()), m_pMapping + m_ArrayOffsets[uArray], uByteCount);
+
+	return true;
+}
+
+template<typename _Vector>
+std::span<const u8> CGeometryFile::GetBytes(const _Vector& rVector) {
+	return { static_cast<const u8*>(static_cast<const void*>(rVector.data())), rVector.size() * sizeof(typename _Vector::value_type) };
+}
+
+#endif // __GEOMETRY_FILE__
\ No newline at end of file
@@ -13,6 +13,8 @@ typedef	int32_t		s32;
 typedef	uint32_t	u32;
 typedef	int64_t		s64;
 typedef	uint64_t	u64;
+__extension__ typedef	__int128			s128;
+__extension__ typedef	unsigned __int128	u128;
 
 #define	s8_MIN		static_cast<s8 >(0x0000000000000080)
 #define	s8_MAX		static_cast<s8 >(0x000000000000007F)
@@ -0,0 +1,37 @@
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "MappedAllocator.h"
+
+// The file is unlinked as soon as it's mapped, so it's reclaimed with the mapping, even if the process dies
+void* allocateMapped(u64 uByteCount) {
+	const char* pDirectory = std::getenv("TMPDIR");
+	std::string path = std::string(pDirectory && *pDirectory ? pDirectory : "/tmp") + "/IcosidodecahedronVectorArtXXXXXX";
+	const s32 sFile = mkstemp(path.data());
+
+	if (sFile < 0) {
+		throw std::bad_alloc();
+	}
+
+	unlink(path.c_str());
+
+	void* pMemory = ftruncate(sFile, uByteCount) ?
+		MAP_FAILED :
+		mmap(nullptr, uByteCount, PROT_READ | PROT_WRITE, MAP_SHARED, sFile, 0);
+
+	close(sFile);
+
+	if (pMemory == MAP_FAILED) {
+		throw std::bad_alloc();
+	}
+
+	return pMemory;
+}
+
+void deallocateMapped(void* pMemory, u64 uByteCount) {
+	munmap(pMemory, uByteCount);
+}
\ No newline at end of file
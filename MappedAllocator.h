@@ -0,0 +1,55 @@
+#ifndef __MAPPED_ALLOCATOR__
+#define __MAPPED_ALLOCATOR__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Defines.h"
+
+// Allocations at least this large are backed by a temporary file rather than the heap
+constexpr const u64 g_kuMappedAllocationThreshold = 1ull << 26;
+
+void*	allocateMapped		(u64 uByteCount);
+void	deallocateMapped	(void* pMemory, u64 uByteCount);
+
+// Places large arrays in memory-mapped temporary files, so that geometry too big for RAM is paged to and from disk by the
+// kernel instead of exhausting memory. Passes over such arrays should be sequential wherever possible, so readahead and
+// writeback keep up with them
+template<typename _Type>
+class CMappedAllocator {
+public:
+	typedef _Type value_type;
+
+	CMappedAllocator() noexcept {}
+
+	template<typename _OtherType>
+	CMappedAllocator(const CMappedAllocator<_OtherType>&) noexcept {}
+
+	_Type*	allocate	(size_t uCount);
+	void	deallocate	(_Type* pMemory, size_t uCount);
+
+	template<typename _OtherType>
+	bool operator==(const CMappedAllocator<_OtherType>&) const noexcept { return true; }
+};
+
+template<typename _Type>
+using CMappedVector = std::vector<_Type, CMappedAllocator<_Type>>;
+
+template<typename _Type>
+_Type* CMappedAllocator<_Type>::allocate(size_t uCount) {
+	return uCount * sizeof(_Type) >= g_kuMappedAllocationThreshold ?
+		static_cast<_Type*>(allocateMapped(uCount * sizeof(_Type))) :
+		std::allocator<_Type>().allocate(uCount);
+}
+
+template<typename _Type>
+void CMappedAllocator<_Type>::deallocate(_Type* pMemory, size_t uCount) {
+	if (uCount * sizeof(_Type) >= g_kuMappedAllocationThreshold) {
+		deallocateMapped(pMemory, uCount * sizeof(_Type));
+	} else {
+		std::allocator<_Type>().deallocate(pMemory, uCount);
+	}
+}
+
+#endif // __MAPPED_ALLOCATOR__
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef __PARALLEL__
+#define __PARALLEL__
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "Defines.h"
+
+// If nonzero, the thread count work is split across in place of the hardware's, as when timing a single thread. Only set it
+// while nothing is running in parallel
+inline u32 g_uThreadCount = 0;
+
+// Splits uCount items into one chunk per hardware thread, without making any chunk smaller than uMinChunkSize
+inline u32 computeChunkCount(u64 uCount, u64 uMinChunkSize) {
+	// hardware_concurrency() may query the OS, and this is called once per block in some loops
+	static const u64 suHardwareThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	return static_cast<u32>(std::clamp<u64>(uCount / std::max<u64>(uMinChunkSize, 1), 1, g_uThreadCount ? g_uThreadCount : suHardwareThreadCount));
+}
+
+constexpr inline u64 computeChunkBegin(u64 uCount, u32 uChunkCount, u32 uChunk) {
+	return uCount * uChunk / uChunkCount;
+}
+
+// Calls rFunc(uChunk) for every chunk in [0, uChunkCount), running chunk 0 on the calling thread
+template<typename _Func>
+void parallelForChunks(u32 uChunkCount, const _Func& rFunc) {
+	if (uChunkCount <= 1) {
+		rFunc(0);
+
+		return;
+	}
+
+	std::vector<std::thread> threads;
+
+	threads.reserve(uChunkCount - 1);
+
+	for (u32 uChunk = 1; uChunk < uChunkCount; ++uChunk) {
+		threads.emplace_back(std::cref(rFunc), uChunk);
+	}
+
+	rFunc(0);
+
+	for (std::thread& rThread : threads) {
+		rThread.join();
+	}
+}
+
+// Calls rFunc(uBegin, uEnd) on contiguous, disjoint ranges covering [0, uCount)
+template<typename _Func>
+void parallelFor(u64 uCount, const _Func& rFunc, u64 uMinChunkSize = 1 << 14) {
+	const u32 uChunkCount = computeChunkCount(uCount, uMinChunkSize);
+
+	parallelForChunks(uChunkCount, [uCount, uChunkCount, &rFunc](u32 uChunk) {
+		rFunc(computeChunkBegin(uCount, uChunkCount, uChunk), computeChunkBegin(uCount, uChunkCount, uChunk + 1));
+	});
+}
+
+#endif // __PARALLEL__
\ No newline at end of file
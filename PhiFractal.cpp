@@ -0,0 +1,169 @@
+#include "PhiFractal.h"
+
+#include "PhiVector.h"
+
+CPhiFractal::CPhiFractal() {}
+
+// Matches CPhiPolyhedron::GenerateIcosahedronFractal: the first level is scaled by phi, and each after it by phi^2 more
+CPhiFractal& CPhiFractal::GenerateIcosahedronFractal(u32 uIteration) {
+	std::vector<CPhiVector> levelScales;
+	CPhiVector scalingVector(0, 1);
+
+	for (u32 l = 0; l < uIteration; ++l) {
+		levelScales.push_back(scalingVector);
+		scalingVector *= CPhiVector(1, 1);
+	}
+
+	return Generate(CPhiPolyhedron::GetIcosahedron(), levelScales);
+}
+
+// Matches CPhiPolyhedron::GenerateIcosidodecahedronFractal: the first level is scaled by 2 * phi, and each after it by
+// phi^3 more
+CPhiFractal& CPhiFractal::GenerateIcosidodecahedronFractal(u32 uIteration) {
+	std::vector<CPhiVector> levelScales;
+	CPhiVector scalingVector(0, 2);
+
+	for (u32 l = 0; l < uIteration; ++l) {
+		levelScales.push_back(scalingVector);
+		scalingVector *= CPhiVector(1, 2);
+	}
+
+	return Generate(CPhiPolyhedron::GetIcosidodecahedron(), levelScales);
+}
+
+// Identifies the fractal by everything it's generated from, for keying cached geometry
+u64 CPhiFractal::ComputeKey() const {
+	u64 uKey = hashWords64(m_Base.m_Vertices.data(), m_Base.m_Vertices.size() * sizeof(CPhiVector3));
+
+	uKey = hashWords64(m_Base.m_Edges.data(), m_Base.m_Edges.size() * sizeof(std::pair<u32, u32>), uKey);
+
+	for (u64 f = 0; f < m_Base.m_Faces.size(); ++f) {
+		const std::span<const u32> face = m_Base.m_Faces[f];
+		const u64 uFaceSize = face.size();
+
+		// Prefixing each face with its size keeps faces from running together
+		uKey = hashWords64(face.data(), face.size_bytes(), hashWords64(&uFaceSize, sizeof(uFaceSize), uKey));
+	}
+
+	for (const std::vector<CPhiVector3>& rLevelTranslations : m_LevelTranslations) {
+		uKey = hashWords64(rLevelTranslations.data(), rLevelTranslations.size() * sizeof(CPhiVector3), uKey);
+	}
+
+	return uKey;
+}
+
+u64 CPhiFractal::GetCopyCount() const {
+	u64 uCopyCount = 1;
+
+	for (u32 l = 0; l < m_LevelTranslations.size(); ++l) {
+		uCopyCount *= m_Base.m_Vertices.size();
+	}
+
+	return uCopyCount;
+}
+
+CPhiVector3 CPhiFractal::GetCopyTranslation(u64 uCopy) const {
+	const u64 uBaseVertCount = m_Base.m_Vertices.size();
+	CPhiVector3 translation;
+
+	for (u32 l = 0; l < m_LevelTranslations.size(); ++l) {
+		translation += m_LevelTranslations[l][uCopy % uBaseVertCount];
+		uCopy /= uBaseVertCount;
+	}
+
+	return translation;
+}
+
+std::pair<u64, u64> CPhiFractal::GetEdge(u64 uEdge) const {
+	const std::pair<u32, u32>& rBaseEdge = m_Base.m_Edges[uEdge % m_Base.m_Edges.size()];
+	const u64 uVertOffset = uEdge / m_Base.m_Edges.size() * m_Base.m_Vertices.size();
+
+	return std::pair<u64, u64>(uVertOffset + rBaseEdge.first, uVertOffset + rBaseEdge.second);
+}
+
+void CPhiFractal::GetFace(u64 uFace, std::vector<u64>& rFace) const {
+	const std::span<const u32> baseFace = m_Base.m_Faces[uFace % m_Base.m_Faces.size()];
+	const u64 uVertOffset = uFace / m_Base.m_Faces.size() * m_Base.m_Vertices.size();
+
+	rFace.resize(baseFace.size());
+
+	for (u32 fv = 0; fv < baseFace.size(); ++fv) {
+		rFace[fv] = uVertOffset + baseFace[fv];
+	}
+}
+
+// Counts heap storage too, so this can be compared against a materialized CPhiPolyhedron's footprint
+u64 CPhiFractal::GetMemoryUsage() const {
+	u64 uMemoryUsage = sizeof(*this) +
+		m_Base.m_Vertices.capacity() * sizeof(CPhiVector3) +
+		m_Base.m_Edges.capacity() * sizeof(std::pair<u32, u32>) +
+		m_Base.m_Faces.GetMemoryUsage() +
+		m_Base.m_VertexLevels.capacity() + m_Base.m_EdgeLevels.capacity() + m_Base.m_FaceLevels.capacity() +
+		m_LevelTranslations.capacity() * sizeof(std::vector<CPhiVector3>);
+
+	for (const std::vector<CPhiVector3>& rLevelTranslations : m_LevelTranslations) {
+		uMemoryUsage += rLevelTranslations.capacity() * sizeof(CPhiVector3);
+	}
+
+	return uMemoryUsage;
+}
+
+CPhiVector3 CPhiFractal::GetVertex(u64 uVert) const {
+	const u64 uBaseVertCount = m_Base.m_Vertices.size();
+
+	return GetCopyTranslation(uVert / uBaseVertCount) + m_Base.m_Vertices[uVert % uBaseVertCount];
+}
+
+// Copying the base once per level, as the generators do, numbers every element the same way
+CPhiPolyhedron CPhiFractal::Materialize() const {
+	CPhiPolyhedron phiPolyhedron(m_Base);
+
+	for (const std::vector<CPhiVector3>& rLevelTranslations : m_LevelTranslations) {
+		phiPolyhedron.CopyForEachVertex(rLevelTranslations);
+	}
+
+	return phiPolyhedron;
+}
+
+// Matches the levels Materialize() gives copy uCopy's elements, advancing level 0 once per fractal level, finest first
+void CPhiFractal::PopulateCopyLevels(u64 uCopy, CMappedVector<u8>& rVertexLevels, CMappedVector<u8>& rEdgeLevels, CMappedVector<u8>& rFaceLevels) const {
+	const u64 uBaseVertCount = m_Base.m_Vertices.size();
+
+	rVertexLevels.assign(uBaseVertCount, 0);
+	rEdgeLevels.assign(m_Base.m_Edges.size(), 0);
+	rFaceLevels.assign(m_Base.m_Faces.size(), 0);
+
+	for (u32 l = 0; l < m_LevelTranslations.size(); ++l) {
+		m_Base.AdvanceLevels(uCopy % uBaseVertCount, uBaseVertCount, rVertexLevels.data(), rEdgeLevels.data(), rFaceLevels.data());
+		uCopy /= uBaseVertCount;
+	}
+}
+
+std::ostream& operator<<(std::ostream& rOStream, const CPhiFractal& rPhiFractal) {
+	rOStream << "{\nBase:\n" << rPhiFractal.m_Base << "Level translations (" << rPhiFractal.m_LevelTranslations.size() << "):\n";
+
+	for (u32 l = 0; l < rPhiFractal.m_LevelTranslations.size(); ++l) {
+		rOStream << "\t" << l << ":";
+
+		for (const CPhiVector3& rTranslation : rPhiFractal.m_LevelTranslations[l]) {
+			rOStream << ' ' << rTranslation;
+		}
+
+		rOStream << '\n';
+	}
+
+	return rOStream << "}\n";
+}
+
+CPhiFractal& CPhiFractal::Generate(const CPhiPolyhedron& rBase, const std::vector<CPhiVector>& rLevelScales) {
+	m_Base = rBase;
+	m_LevelTranslations.clear();
+
+	for (const CPhiVector& rLevelScale : rLevelScales) {
+		const CPhiPolyhedron scaledBase = rBase * rLevelScale;
+
+		m_LevelTranslations.emplace_back(scaledBase.m_Vertices.begin(), scaledBase.m_Vertices.end());
+	}
+
+	return *this;
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef __PHI_FRACTAL__
+#define __PHI_FRACTAL__
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "Defines.h"
+
+#include "PhiPolyhedron.h"
+#include "PhiVector3.h"
+
+// Forward Declarations
+class CPhiVector;
+
+// A fractal of copies of a base polyhedron, stored as the base plus one translation table per level rather than as every
+// copy's vertices, edges and faces. Its elements are numbered exactly as CPhiPolyhedron::CopyForEachVertex numbers them:
+// element i is element (i % n) of copy (i / n), where n is the base's element count, and the copy index's base-v digits
+// (v being the base's vertex count) select one translation per level, least significant digit first.
+class CPhiFractal {
+// Functions
+public:
+	CPhiFractal();
+
+	CPhiFractal&	GenerateIcosahedronFractal			(u32 uIteration);
+	CPhiFractal&	GenerateIcosidodecahedronFractal	(u32 uIteration);
+
+			u64				ComputeKey			()								const;
+	const	CPhiPolyhedron&	GetBase				()								const { return m_Base; }
+			u64				GetCopyCount		()								const;
+			CPhiVector3		GetCopyTranslation	(u64 uCopy)						const;
+			std::pair<u64, u64>	GetEdge			(u64 uEdge)						const;
+			u64				GetEdgeCount		()								const { return GetCopyCount() * m_Base.m_Edges.size(); }
+			void			GetFace				(u64 uFace, std::vector<u64>& rFace)	const;
+			u64				GetFaceCount		()								const { return GetCopyCount() * m_Base.m_Faces.size(); }
+			u32				GetLevelCount		()								const { return m_LevelTranslations.size(); }
+	const	std::vector<CPhiVector3>&	GetLevelTranslations	(u32 uLevel)	const { return m_LevelTranslations[uLevel]; }
+			u64				GetMemoryUsage		()								const;
+			CPhiVector3		GetVertex			(u64 uVert)						const;
+			u64				GetVertexCount		()								const { return GetCopyCount() * m_Base.m_Vertices.size(); }
+			CPhiPolyhedron	Materialize			()								const;
+			void			PopulateCopyLevels	(u64 uCopy, CMappedVector<u8>& rVertexLevels, CMappedVector<u8>& rEdgeLevels, CMappedVector<u8>& rFaceLevels)	const;
+
+	// Calls rFunc(uVert, rVertex) for every vertex in [uBegin, uEnd), updating the translation incrementally
+	template<typename _Func>
+	void ForEachVertex(const _Func& rFunc, u64 uBegin = 0, u64 uEnd = u64_MAX) const;
+
+	// Calls rFunc(uFace, rFace) for every face in [uBegin, uEnd)
+	template<typename _Func>
+	void ForEachFace(const _Func& rFunc, u64 uBegin = 0, u64 uEnd = u64_MAX) const;
+
+	friend std::ostream& operator<<(std::ostream& rOStream, const CPhiFractal& rPhiFractal);
+private:
+	CPhiFractal&	Generate	(const CPhiPolyhedron& rBase, const std::vector<CPhiVector>& rLevelScales);
+
+// Variables
+private:
+	CPhiPolyhedron							m_Base;
+	std::vector<std::vector<CPhiVector3>>	m_LevelTranslations;	// Per level, the base's vertices scaled for that level
+};
+
+template<typename _Func>
+void CPhiFractal::ForEachVertex(const _Func& rFunc, u64 uBegin, u64 uEnd) const {
+	const u64 uBaseVertCount = m_Base.m_Vertices.size();
+
+	uEnd = std::min(uEnd, GetVertexCount());
+
+	if (uBegin >= uEnd) {
+		return;
+	}
+
+	const u32 uLevelCount = GetLevelCount();
+	std::vector<u64> digits(uLevelCount);
+
+	// partialSums[l] is the sum of the translations selected by digits l and above, so partialSums[0] is the copy's
+	std::vector<CPhiVector3> partialSums(uLevelCount + 1);
+	u64 uCopy = uBegin / uBaseVertCount;
+
+	for (u32 l = 0; l < uLevelCount; ++l) {
+		digits[l] = uCopy % uBaseVertCount;
+		uCopy /= uBaseVertCount;
+	}
+
+	for (u32 l = uLevelCount; l-- > 0;) {
+		partialSums[l] = partialSums[l + 1] + m_LevelTranslations[l][digits[l]];
+	}
+
+	u64 uVert = uBegin;
+	u32 uBaseVert = uBegin % uBaseVertCount;
+
+	while (true) {
+		for (; uBaseVert < uBaseVertCount && uVert < uEnd; ++uBaseVert, ++uVert) {
+			rFunc(uVert, partialSums[0] + m_Base.m_Vertices[uBaseVert]);
+		}
+
+		if (uVert >= uEnd) {
+			return;
+		}
+
+		// Increment the copy index like an odometer, then rebuild only the partial sums of the digits that changed
+		u32 uChangedLevel = 0;
+
+		while (++digits[uChangedLevel] == uBaseVertCount) {
+			digits[uChangedLevel++] = 0;
+		}
+
+		for (u32 l = uChangedLevel + 1; l-- > 0;) {
+			partialSums[l] = partialSums[l + 1] + m_LevelTranslations[l][digits[l]];
+		}
+
+		uBaseVert = 0;
+	}
+}
+
+template<typename _Func>
+void CPhiFractal::ForEachFace(const _Func& rFunc, u64 uBegin, u64 uEnd) const {
+	const u64 uBaseFaceCount = m_Base.m_Faces.size();
+	const u64 uBaseVertCount = m_Base.m_Vertices.size();
+	std::vector<u64> face;
+
+	uEnd = std::min(uEnd, GetFaceCount());
+
+	for (u64 uFace = uBegin; uFace < uEnd; ++uFace) {
+		const std::span<const u32> baseFace = m_Base.m_Faces[uFace % uBaseFaceCount];
+		const u64 uVertOffset = uFace / uBaseFaceCount * uBaseVertCount;
+
+		face.resize(baseFace.size());
+
+		for (u32 fv = 0; fv < baseFace.size(); ++fv) {
+			face[fv] = uVertOffset + baseFace[fv];
+		}
+
+		rFunc(uFace, static_cast<const std::vector<u64>&>(face));
+	}
+}
+
+#endif // __PHI_FRACTAL__
\ No newline at end of file
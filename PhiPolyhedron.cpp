@@ -1,49 +1,117 @@
-#include <bit>
+#include <algorithm>
 #include <iomanip>
+#include <stdexcept>
 
 #include "PhiPolyhedron.h"
 
+#include "GeometryFile.h"
+#include "Parallel.h"
+#include "PhiPolyhedronTables.h"
 #include "PhiVector.h"
 #include "PhiVector3.h"
 
+// Version 1 of the CPhiPolyhedron layout
+constexpr const u64 g_kuPhiGeometryFormat = 0x0000000100000001ull;
+
 CPhiPolyhedron::CPhiPolyhedron() {}
 
-CPhiPolyhedron& CPhiPolyhedron::CopyForEachVertex(const std::vector<CPhiVector3>& rVertices) {
-	const u32 uInitialVertCount = m_Vertices.size();
-	const u32 uInitialEdgeCount = m_Edges.size();
-	const u32 uInitialFaceCount = m_Faces.size();
-	u32 uVertCount = uInitialVertCount;
+// Updates the levels of this polyhedron's elements, in place, for the copy of it placed at base vertex uCopyVert: an
+// element stays at level 0 only if it was at level 0 and lies on that vertex, and otherwise moves one level finer. Vertex
+// indices reduced modulo uBaseVertCount are the base's, since every copy's vertices are offset by a multiple of it
+void CPhiPolyhedron::AdvanceLevels(u64 uCopyVert, u64 uBaseVertCount, u8* pVertexLevels, u8* pEdgeLevels, u8* pFaceLevels) const {
+	const auto advanceLevel = [](u8& ruLevel, bool bIsOnCopyVert) {
+		ruLevel = !ruLevel && bIsOnCopyVert ? 0 : ruLevel + 1;
+	};
 
-	if (rVertices.size() > 1) {
-		for (u32 uRootVertIndex = 1; uRootVertIndex < rVertices.size(); ++uRootVertIndex) {
+	for (u64 v = 0; v < m_Vertices.size(); ++v) {
+		advanceLevel(pVertexLevels[v], v % uBaseVertCount == uCopyVert);
+	}
 
-			for (u32 uCopyVertIndex = 0; uCopyVertIndex < uInitialVertCount; ++uCopyVertIndex) {
-				m_Vertices.emplace_back(rVertices[uRootVertIndex] + m_Vertices[uCopyVertIndex]);
-			}
+	for (u64 e = 0; e < m_Edges.size(); ++e) {
+		advanceLevel(pEdgeLevels[e], m_Edges[e].first % uBaseVertCount == uCopyVert || m_Edges[e].second % uBaseVertCount == uCopyVert);
+	}
 
-			for (u32 uCopyEdgeIndex = 0; uCopyEdgeIndex < uInitialEdgeCount; ++uCopyEdgeIndex) {
-				const std::pair<u32, u32>& rCopyEdge = m_Edges[uCopyEdgeIndex];
-				m_Edges.emplace_back(uVertCount + rCopyEdge.first, uVertCount + rCopyEdge.second);
-			}
+	for (u64 f = 0; f < m_Faces.size(); ++f) {
+		bool bIsOnCopyVert = false;
+
+		for (u32 uVertIndex : m_Faces[f]) {
+			bIsOnCopyVert |= uVertIndex % uBaseVertCount == uCopyVert;
+		}
+
+		advanceLevel(pFaceLevels[f], bIsOnCopyVert);
+	}
+}
+
+// Replaces this with one copy of itself translated to each of vertices, copy r's elements following copy r - 1's. If
+// levels are tracked, vertices are taken to be the base's, scaled, so that copy r lies on base vertex r
+CPhiPolyhedron& CPhiPolyhedron::CopyForEachVertex(std::span<const CPhiVector3> vertices) {
+	const u64 uInitialVertCount = m_Vertices.size();
+	const u64 uInitialEdgeCount = m_Edges.size();
+	const u64 uInitialFaceCount = m_Faces.size();
+	const u64 uCopyCount = vertices.size();
 
-			for (u32 uCopyFaceIndex = 0; uCopyFaceIndex < uInitialFaceCount; ++uCopyFaceIndex) {
-				std::vector<u32> copyFace = m_Faces[uCopyFaceIndex];
+	if (!uCopyCount) {
+		return *this;
+	}
 
-				for (u32 uFaceVert = 0; uFaceVert < copyFace.size(); ++uFaceVert) {
-					copyFace[uFaceVert] += uVertCount;
-				}
+	// Edges and faces index vertices with u32s, which would silently wrap past this
+	if (uInitialVertCount > u32_MAX / uCopyCount) {
+		throw std::length_error("CPhiPolyhedron::CopyForEachVertex: the copies' vertex count overflows a u32 index");
+	}
 
-				m_Faces.push_back(copyFace);
+	if (m_VertexLevels.size()) {
+		CMappedVector<u8> vertexLevels(uInitialVertCount * uCopyCount);
+		CMappedVector<u8> edgeLevels(uInitialEdgeCount * uCopyCount);
+		CMappedVector<u8> faceLevels(uInitialFaceCount * uCopyCount);
+
+		parallelFor(uCopyCount, [&](u64 uBegin, u64 uEnd) {
+			for (u64 uCopy = uBegin; uCopy < uEnd; ++uCopy) {
+				u8* pVertexLevels = vertexLevels.data() + uCopy * uInitialVertCount;
+				u8* pEdgeLevels = edgeLevels.data() + uCopy * uInitialEdgeCount;
+				u8* pFaceLevels = faceLevels.data() + uCopy * uInitialFaceCount;
+
+				std::copy(m_VertexLevels.begin(), m_VertexLevels.end(), pVertexLevels);
+				std::copy(m_EdgeLevels.begin(), m_EdgeLevels.end(), pEdgeLevels);
+				std::copy(m_FaceLevels.begin(), m_FaceLevels.end(), pFaceLevels);
+				AdvanceLevels(uCopy, uCopyCount, pVertexLevels, pEdgeLevels, pFaceLevels);
 			}
+		}, std::max<u64>((1 << 14) / std::max<u64>(uInitialVertCount, 1), 1));
 
-			uVertCount += uInitialVertCount;
-		}
+		m_VertexLevels.swap(vertexLevels);
+		m_EdgeLevels.swap(edgeLevels);
+		m_FaceLevels.swap(faceLevels);
 	}
 
-	for (u32 uOrigVertIndex = 0; uOrigVertIndex < uInitialVertCount; ++uOrigVertIndex) {
-		m_Vertices[uOrigVertIndex] += rVertices[0];
+	m_Vertices.resize(uInitialVertCount * uCopyCount);
+	m_Edges.resize(uInitialEdgeCount * uCopyCount);
+
+	// Copies 1 and up read the untranslated original, so they're filled before it's translated in place as copy 0
+	parallelFor(uCopyCount - 1, [&](u64 uBegin, u64 uEnd) {
+		for (u64 uCopy = uBegin + 1; uCopy <= uEnd; ++uCopy) {
+			const CPhiVector3 translation = vertices[uCopy];
+			const u32 uVertOffset = uCopy * uInitialVertCount;
+			const CPhiVector3* pSrcVerts = m_Vertices.data();
+			CPhiVector3* pDstVerts = m_Vertices.data() + uVertOffset;
+			const std::pair<u32, u32>* pSrcEdges = m_Edges.data();
+			std::pair<u32, u32>* pDstEdges = m_Edges.data() + uCopy * uInitialEdgeCount;
+
+			// Independent, contiguous and branch-free, so these loops vectorize
+			for (u64 v = 0; v < uInitialVertCount; ++v) {
+				pDstVerts[v] = pSrcVerts[v] + translation;
+			}
+
+			for (u64 e = 0; e < uInitialEdgeCount; ++e) {
+				pDstEdges[e] = std::pair<u32, u32>(pSrcEdges[e].first + uVertOffset, pSrcEdges[e].second + uVertOffset);
+			}
+		}
+	}, std::max<u64>((1 << 14) / std::max<u64>(uInitialVertCount, 1), 1));
+
+	for (u64 v = 0; v < uInitialVertCount; ++v) {
+		m_Vertices[v] += vertices[0];
 	}
 
+	m_Faces.Repeat(uCopyCount, uInitialVertCount);
+
 	return *this;
 }
 
@@ -55,7 +123,7 @@ CPhiPolyhedron& CPhiPolyhedron::GenerateIcosahedronFractal(u32 uIteration) {
 	}
 
 	CPhiPolyhedron scalingIcosahedron(GetIcosahedron());
-	CPhiVector scalingVector(std::vector<s32>{0, 1});
+	CPhiVector scalingVector(0, 1);
 
 	scalingIcosahedron *= scalingVector;
 	CopyForEachVertex(scalingIcosahedron.m_Vertices);
@@ -78,10 +146,10 @@ CPhiPolyhedron& CPhiPolyhedron::GenerateIcosidodecahedronFractal(u32 uIteration)
 
 	CPhiPolyhedron scalingPolyhedron(GetIcosidodecahedron());
 
-	scalingPolyhedron *= std::vector<s32>{0, 2};
+	scalingPolyhedron *= CPhiVector(0, 2);
 	CopyForEachVertex(scalingPolyhedron.m_Vertices);
 
-	CPhiVector scalingVector(std::vector<s32>{0, 1, 1});
+	CPhiVector scalingVector(1, 2);
 
 	while (--uIteration) {
 		scalingPolyhedron *= scalingVector;
@@ -91,20 +159,81 @@ CPhiPolyhedron& CPhiPolyhedron::GenerateIcosidodecahedronFractal(u32 uIteration)
 	return *this;
 }
 
-const CPhiPolyhedron& CPhiPolyhedron::GetIcosahedron() {
-	if (!m_sIcosahedron.m_Vertices.size()) {
-		GenerateIcosahedron();
+// Loads geometry saved by SaveGeometry() under the same key, leaving this empty if the file is missing or invalid
+bool CPhiPolyhedron::LoadGeometry(const std::string& rFileName, u64 uKey) {
+	CGeometryFile file;
+
+	if (!(file.Map(rFileName, g_kuPhiGeometryFormat, uKey) &&
+		file.CopyArray(0, m_Vertices) &&
+		file.CopyArray(1, m_Edges) &&
+		m_Faces.CopyArrays(file, 2) &&
+		file.CopyArray(4, m_VertexLevels) &&
+		file.CopyArray(5, m_EdgeLevels) &&
+		file.CopyArray(6, m_FaceLevels))) {
+
+		*this = CPhiPolyhedron();
+
+		return false;
 	}
 
-	return m_sIcosahedron;
+	return true;
 }
 
-const CPhiPolyhedron& CPhiPolyhedron::GetIcosidodecahedron() {
-	if (!m_sIcosidodecahedron.m_Vertices.size()) {
-		GenerateIcosidodecahedron();
+// Converts m_Vertices[uBegin, uEnd) into rVertexCoordinates, reusing its capacity
+void CPhiPolyhedron::PopulateVertexCoordinates(SVertexCoordinates& rVertexCoordinates, u64 uBegin, u64 uEnd) const {
+	uEnd = std::min<u64>(uEnd, m_Vertices.size());
+
+	const u64 uVertCount = uEnd - uBegin;
+
+	for (std::vector<f64>& rCoordinates : rVertexCoordinates.m_Coordinates) {
+		rCoordinates.resize(uVertCount);
 	}
 
-	return m_sIcosidodecahedron;
+	rVertexCoordinates.m_ErrorBounds.resize(uVertCount);
+
+	// Each coordinate is a branch-free dot product of (a, b) with (1, phi), written to its own contiguous array
+	parallelFor(uVertCount, [&](u64 uChunkBegin, u64 uChunkEnd) {
+		const CPhiVector3* pVerts = m_Vertices.data() + uBegin;
+		f64* pX = rVertexCoordinates.m_Coordinates[0].data();
+		f64* pY = rVertexCoordinates.m_Coordinates[1].data();
+		f64* pZ = rVertexCoordinates.m_Coordinates[2].data();
+		f64* pErrorBounds = rVertexCoordinates.m_ErrorBounds.data();
+
+		for (u64 v = uChunkBegin; v < uChunkEnd; ++v) {
+			const CPhiVector3& rVert = pVerts[v];
+
+			pX[v] = rVert.x.GetF64();
+			pY[v] = rVert.y.GetF64();
+			pZ[v] = rVert.z.GetF64();
+			pErrorBounds[v] = std::max({
+				rVert.x.GetF64ErrorBound(),
+				rVert.y.GetF64ErrorBound(),
+				rVert.z.GetF64ErrorBound() });
+		}
+	});
+}
+
+const CPhiPolyhedron& CPhiPolyhedron::GetIcosahedron() {
+	static const CPhiPolyhedron sIcosahedron(CreateFromTable(g_kIcosahedronTable));
+
+	return sIcosahedron;
+}
+
+const CPhiPolyhedron& CPhiPolyhedron::GetIcosidodecahedron() {
+	static const CPhiPolyhedron sIcosidodecahedron(CreateFromTable(g_kIcosidodecahedronTable));
+
+	return sIcosidodecahedron;
+}
+
+bool CPhiPolyhedron::SaveGeometry(const std::string& rFileName, u64 uKey) const {
+	std::vector<std::span<const u8>> arrays = { CGeometryFile::GetBytes(m_Vertices), CGeometryFile::GetBytes(m_Edges) };
+
+	m_Faces.AppendArrays(arrays);
+	arrays.push_back(CGeometryFile::GetBytes(m_VertexLevels));
+	arrays.push_back(CGeometryFile::GetBytes(m_EdgeLevels));
+	arrays.push_back(CGeometryFile::GetBytes(m_FaceLevels));
+
+	return CGeometryFile::Save(rFileName, g_kuPhiGeometryFormat, uKey, arrays);
 }
 
 CPhiPolyhedron CPhiPolyhedron::operator*(const CPhiVector& rPhiVector) const {
@@ -116,7 +245,7 @@ CPhiPolyhedron CPhiPolyhedron::operator*(s32 sScalar) const {
 }
 
 CPhiPolyhedron& CPhiPolyhedron::operator*=(const CPhiVector& rPhiVector) {
-	for (u32 v = 0; v < m_Vertices.size(); ++v) {
+	for (u64 v = 0; v < m_Vertices.size(); ++v) {
 		m_Vertices[v] *= rPhiVector;
 	}
 
@@ -124,7 +253,7 @@ CPhiPolyhedron& CPhiPolyhedron::operator*=(const CPhiVector& rPhiVector) {
 }
 
 CPhiPolyhedron& CPhiPolyhedron::operator*=(s32 sScalar) {
-	for (u32 v = 0; v < m_Vertices.size(); ++v) {
+	for (u64 v = 0; v < m_Vertices.size(); ++v) {
 		m_Vertices[v] *= sScalar;
 	}
 
@@ -134,28 +263,28 @@ CPhiPolyhedron& CPhiPolyhedron::operator*=(s32 sScalar) {
 std::ostream& operator<<(std::ostream& rOStream, const CPhiPolyhedron& rPhiPolyhedron) {
 	rOStream << "{\nVertices (" << rPhiPolyhedron.m_Vertices.size() << "):\n";
 
-	for (u32 v = 0; v < rPhiPolyhedron.m_Vertices.size(); ++v) {
+	for (u64 v = 0; v < rPhiPolyhedron.m_Vertices.size(); ++v) {
 		rOStream << "\t" << std::setw(4) << v << ": " << rPhiPolyhedron.m_Vertices[v] << '\n';
 	}
 
 	rOStream << "Edges (" << rPhiPolyhedron.m_Edges.size() << "):\n";
 
-	for (u32 e = 0; e < rPhiPolyhedron.m_Edges.size(); ++e) {
+	for (u64 e = 0; e < rPhiPolyhedron.m_Edges.size(); ++e) {
 		const std::pair<u32, u32>& rEdge = rPhiPolyhedron.m_Edges[e];
 		rOStream << "\t" << std::setw(4) << e << ": (" << rEdge.first << ", " << rEdge.second << ")\n";
 	}
 
 	rOStream << "Faces (" << rPhiPolyhedron.m_Faces.size() << "):\n";
 
-	for (u32 f = 0; f < rPhiPolyhedron.m_Faces.size(); ++f) {
-		const std::vector<u32>& rFace = rPhiPolyhedron.m_Faces[f];
+	for (u64 f = 0; f < rPhiPolyhedron.m_Faces.size(); ++f) {
+		const std::span<const u32> face = rPhiPolyhedron.m_Faces[f];
 		rOStream << "\t" << std::setw(4) << f << ": (";
 
-		if (rFace.size()) {
-			rOStream << rFace[0];
+		if (face.size()) {
+			rOStream << face[0];
 
-			for (u32 fv = 1; fv < rFace.size(); ++fv) {
-				rOStream << ", " << rFace[fv];
+			for (u32 fv = 1; fv < face.size(); ++fv) {
+				rOStream << ", " << face[fv];
 			}
 		}
 
@@ -165,154 +294,23 @@ std::ostream& operator<<(std::ostream& rOStream, const CPhiPolyhedron& rPhiPolyh
 	return rOStream << "}\n";
 }
 
-void CPhiPolyhedron::GenerateIcosahedron() {
-	const CPhiVector3 baseVector(
-		std::vector<s32>{1},
-		std::vector<s32>{0, 1},
-		std::vector<s32>{0});
-
-	std::vector<CPhiVector3>& rVerts = m_sIcosahedron.m_Vertices;
-
-	for (u32 i = 0; i < 3; ++i) {
-		for (u32 j = 0; j < 4; ++j) {
-			const CPhiVector3 reflectedVector(
-				baseVector.x * (j & 2 ? -1 : 1),
-				baseVector.y * (j & 1 ? -1 : 1),
-				baseVector.z);
-
-			rVerts.emplace_back(
-				reflectedVector[(i    ) % 3],
-				reflectedVector[(i + 1) % 3],
-				reflectedVector[(i + 2) % 3]);
-		}
-	}
-
-	std::vector<std::pair<u32, u32>>& rEdges = m_sIcosahedron.m_Edges;
-	std::vector<std::vector<u32>>& rFaces = m_sIcosahedron.m_Faces;
-
-	for (u32 i = 0; i < 11; ++i) {
-		for (u32 j = i + 1; j < 12; ++j) {
-			if (static_cast<f32>((rVerts[i] - rVerts[j]).GetMagnitudeSquared()) < 5.0f) {
-				rEdges.emplace_back(i, j);
-
-				for (u32 k = j + 1; k < 12; ++k) {
-					if (static_cast<f32>((rVerts[i] - rVerts[k]).GetMagnitudeSquared()) < 5.0f &&
-						static_cast<f32>((rVerts[j] - rVerts[k]).GetMagnitudeSquared()) < 5.0f) {
-						rFaces.push_back(std::vector<u32>{i, j, k});
-					}
-				}
-			}
-		}
-	}
-}
-
-void CPhiPolyhedron::GenerateIcosidodecahedron() {
-	std::vector<CPhiVector3>& rIcosaVerts = m_sIcosahedron.m_Vertices;
-
-	if (!rIcosaVerts.size()) {
-		GenerateIcosahedron();
-	}
-
-	std::vector<std::pair<u32, u32>>& rIcosaEdges = m_sIcosahedron.m_Edges;
-	std::vector<CPhiVector3>& rVerts = m_sIcosidodecahedron.m_Vertices;
+template<typename _Table>
+CPhiPolyhedron CPhiPolyhedron::CreateFromTable(const _Table& rTable) {
+	CPhiPolyhedron phiPolyhedron;
 
-	for (u32 i = 0; i < 30; ++i) {
-		const std::pair<u32, u32>& rIcosaEdge = rIcosaEdges[i];
+	phiPolyhedron.m_Vertices.assign(rTable.m_Vertices.begin(), rTable.m_Vertices.end());
+	phiPolyhedron.m_Edges.assign(rTable.m_Edges.begin(), rTable.m_Edges.end());
+	phiPolyhedron.m_Faces.Reserve(rTable.m_FaceOffsets.size() - 1, rTable.m_FaceIndices.size());
 
-		rVerts.emplace_back(rIcosaVerts[rIcosaEdge.first] + rIcosaVerts[rIcosaEdge.second]);
+	for (u32 f = 0; f + 1 < rTable.m_FaceOffsets.size(); ++f) {
+		phiPolyhedron.m_Faces.PushBack(
+			rTable.m_FaceIndices.begin() + rTable.m_FaceOffsets[f],
+			rTable.m_FaceIndices.begin() + rTable.m_FaceOffsets[f + 1]);
 	}
 
-	std::vector<std::pair<u32, u32>>& rEdges = m_sIcosidodecahedron.m_Edges;
-	std::vector<u32> edgeMap(30, 0);
-
-	for (u32 i = 0; i < 29; ++i) {
-		for (u32 j = i + 1; j < 30; ++j) {
-			if (static_cast<f32>((rVerts[i] - rVerts[j]).GetMagnitudeSquared()) < 5.0f) {
-				rEdges.emplace_back(i, j);
-				edgeMap[i] |= 1 << j;
-				edgeMap[j] |= 1 << i;
-			}
-		}
-	}
-
-	const CPhiVector adjacentPhiVectorSquared(std::vector<s32>{4});
-	const CPhiVector acrossPhiVectorSquared(std::vector<s32>{0, 0, 4});
-	std::vector<std::vector<u32>>& rFaces = m_sIcosidodecahedron.m_Faces;
-	std::vector<u32> octants(8, 0);
-
-	for (u32 i = 0; i < 30; ++i) {
-		CPhiVector3& rVert = rVerts[i];
-
-		if (!rVert.x[0] && !rVert.y[0] && !rVert.z[0]) {
-			u32 aNeighbors[4];
-			u32 uEdges = edgeMap[i];
-
-			// Unpack the adjacent vertex indices
-			for (u32 n = 0; n < 4; ++n) {
-				aNeighbors[n] = std::countr_zero(uEdges);
-				uEdges &= ~(1 << aNeighbors[n]);
-			}
-
-			// Make aNeighbors[0] and aNeighbors[1] be on the same pentagon (likewise with 2 and 3)
-			for (u32 n = 1; n < 4; ++n) {
-				if ((rVerts[aNeighbors[0]] - rVerts[aNeighbors[n]]).GetMagnitudeSquared() <=> acrossPhiVectorSquared == 0) {
-					std::swap(aNeighbors[n], aNeighbors[1]);
-
-					break;
-				}
-			}
-
-			// Make aNeighbors[0] and aNeighbors[2] be on the same triangle (likewise with 1 and 3)
-			if ((rVerts[aNeighbors[0]] - rVerts[aNeighbors[2]]).GetMagnitudeSquared() <=> adjacentPhiVectorSquared != 0) {
-				std::swap(aNeighbors[2], aNeighbors[3]);
-			}
-
-			rFaces.push_back(std::vector<u32>{i, aNeighbors[0], aNeighbors[2]});
-			rFaces.push_back(std::vector<u32>{i, aNeighbors[1], aNeighbors[3]});
-
-			u32 aAcrosses[4];
-
-			for (u32 n = 0; n < 4; ++n) {
-				u32 uNeighborEdges = edgeMap[aNeighbors[n]];
-
-				for (u32 a = 0; a < 4; ++a) {
-					u32 uAcross = std::countr_zero(uNeighborEdges);
-
-					if ((rVerts[i] - rVerts[uAcross]).GetMagnitudeSquared() <=> acrossPhiVectorSquared == 0) {
-						aAcrosses[n] = uAcross;
-
-						break;
-					}
-
-					uNeighborEdges &= ~(1 << uAcross);
-				}
-			}
-
-			rFaces.push_back(std::vector<u32>{i, aNeighbors[0], aAcrosses[0], aAcrosses[1], aNeighbors[1]});
-			rFaces.push_back(std::vector<u32>{i, aNeighbors[2], aAcrosses[2], aAcrosses[3], aNeighbors[3]});
-		} else {
-			octants[
-				((static_cast<f32>(rVert.x) < 0.0)     ) |
-				((static_cast<f32>(rVert.y) < 0.0) << 1) |
-				((static_cast<f32>(rVert.z) < 0.0) << 2)] |= 1 << i; 
-		}
-	}
-
-	for (u32 o = 0; o < 8; ++o) {
-		std::vector<u32> face;
-		u32 uOctant = octants[o];
-
-		// Unpack the octant vertex indices
-		for (u32 n = 0; n < 3; ++n) {
-			u32 vert = std::countr_zero(uOctant);
-
-			uOctant &= ~(1 << vert);
-			face.emplace_back(vert);
-		}
-
-		rFaces.push_back(face);
-	}
-}
+	phiPolyhedron.m_VertexLevels.assign(phiPolyhedron.m_Vertices.size(), 0);
+	phiPolyhedron.m_EdgeLevels.assign(phiPolyhedron.m_Edges.size(), 0);
+	phiPolyhedron.m_FaceLevels.assign(phiPolyhedron.m_Faces.size(), 0);
 
-CPhiPolyhedron CPhiPolyhedron::m_sIcosahedron;
-CPhiPolyhedron CPhiPolyhedron::m_sIcosidodecahedron;
\ No newline at end of file
+	return phiPolyhedron;
+}
\ No newline at end of file
@@ -1,24 +1,42 @@
 #ifndef __PHI_POLYHEDRON__
 #define __PHI_POLYHEDRON__
 
+#include <array>
 #include <iostream>
+#include <span>
+#include <string>
 #include <tuple>
 #include <vector>
 
 #include "Defines.h"
 
+#include "FaceList.h"
+#include "MappedAllocator.h"
+
 // Forward Declarations
 class CPhiVector;
 class CPhiVector3;
 
 class CPhiPolyhedron {
+// Structs
+public:
+	// Structure-of-arrays f64 conversion of m_Vertices
+	struct SVertexCoordinates {
+		std::array<std::vector<f64>, 3>	m_Coordinates;	// x, y and z
+		std::vector<f64>				m_ErrorBounds;	// Of each vertex's least accurate coordinate
+	};
+
 // Functions
 public:
 	CPhiPolyhedron();
 
-	CPhiPolyhedron&	CopyForEachVertex					(const std::vector<CPhiVector3>& rVertices);
+	void			AdvanceLevels						(u64 uCopyVert, u64 uBaseVertCount, u8* pVertexLevels, u8* pEdgeLevels, u8* pFaceLevels)	const;
+	CPhiPolyhedron&	CopyForEachVertex					(std::span<const CPhiVector3> vertices);
 	CPhiPolyhedron&	GenerateIcosahedronFractal			(u32 uIteration);
 	CPhiPolyhedron&	GenerateIcosidodecahedronFractal	(u32 uIteration);
+	bool			LoadGeometry						(const std::string& rFileName, u64 uKey);
+	void			PopulateVertexCoordinates			(SVertexCoordinates& rVertexCoordinates, u64 uBegin = 0, u64 uEnd = u64_MAX)	const;
+	bool			SaveGeometry						(const std::string& rFileName, u64 uKey)										const;
 
 	static	const	CPhiPolyhedron&	GetIcosahedron();
 	static	const	CPhiPolyhedron&	GetIcosidodecahedron();
@@ -30,17 +48,21 @@ public:
 
 	friend std::ostream& operator<<(std::ostream& rOStream, const CPhiPolyhedron& rPhiPolyhedron);
 private:
-	static	void	GenerateIcosahedron();
-	static	void	GenerateIcosidodecahedron();
+	template<typename _Table>
+	static	CPhiPolyhedron	CreateFromTable(const _Table& rTable);
 
 // Variables
 public:
-	std::vector<CPhiVector3>			m_Vertices;
-	std::vector<std::pair<u32, u32>>	m_Edges;
-	std::vector<std::vector<u32>>		m_Faces;
-private:
-	static	CPhiPolyhedron	m_sIcosahedron;
-	static	CPhiPolyhedron	m_sIcosidodecahedron;
+	CMappedVector<CPhiVector3>			m_Vertices;
+	CMappedVector<std::pair<u32, u32>>	m_Edges;
+	CFaceList							m_Faces;
+
+	// Per element, how deep it lies within the fractal: the levels left over once the finest levels whose copies each
+	// place it on their copy vertex are peeled away, so 0 on the outline. Colors elements, or culls detail. Empty if not
+	// tracked
+	CMappedVector<u8>					m_VertexLevels;
+	CMappedVector<u8>					m_EdgeLevels;
+	CMappedVector<u8>					m_FaceLevels;
 };
 
 #endif // __PHI_POLYHEDRON__
\ No newline at end of file
@@ -0,0 +1,280 @@
+#ifndef __PHI_POLYHEDRON_TABLES__
+#define __PHI_POLYHEDRON_TABLES__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <initializer_list>
+#include <utility>
+
+#include "Defines.h"
+#include "PhiVector.h"
+#include "PhiVector3.h"
+
+// Structs
+// A base polyhedron as flat arrays. Face f's vertex indices are m_FaceIndices[m_FaceOffsets[f]] up to (but excluding)
+// m_FaceIndices[m_FaceOffsets[f + 1]], wound so that the face normal points away from the origin
+template<u32 uVertCount, u32 uEdgeCount, u32 uFaceCount, u32 uFaceIndexCount>
+struct SPhiPolyhedronTable {
+	static_assert(uVertCount - uEdgeCount + uFaceCount == 2, "Base polyhedra must be convex (Euler characteristic of 2)");
+
+	std::array<CPhiVector3, uVertCount>			m_Vertices;
+	std::array<std::pair<u32, u32>, uEdgeCount>	m_Edges;
+	std::array<u32, uFaceCount + 1>				m_FaceOffsets;
+	std::array<u32, uFaceIndexCount>			m_FaceIndices;
+};
+
+typedef SPhiPolyhedronTable<12, 30, 20, 60>		SIcosahedronTable;
+typedef SPhiPolyhedronTable<30, 60, 32, 120>	SIcosidodecahedronTable;
+
+// Constants
+// Both base polyhedra have an edge length of 2, so any closer pair of vertices is an edge
+constexpr const CPhiVector	g_kBaseEdgeLengthSquared(4);
+
+// Functions
+template<u32 uVertCount, u32 uEdgeCount, u32 uFaceCount, u32 uFaceIndexCount>
+constexpr inline void orientFacesOutward(SPhiPolyhedronTable<uVertCount, uEdgeCount, uFaceCount, uFaceIndexCount>& rTable) {
+	// The polyhedron is centered on the origin, so a face is wound outward iff its normal points away from the origin
+	for (u32 uFace = 0; uFace < uFaceCount; ++uFace) {
+		u32* pFace = rTable.m_FaceIndices.data() + rTable.m_FaceOffsets[uFace];
+		u32* pFaceEnd = rTable.m_FaceIndices.data() + rTable.m_FaceOffsets[uFace + 1];
+		const CPhiVector3& rVert0 = rTable.m_Vertices[pFace[0]];
+		const CPhiVector3 normal = (rTable.m_Vertices[pFace[1]] - rVert0).Cross(rTable.m_Vertices[pFace[2]] - rVert0);
+
+		if (normal.Dot(rVert0).GetSign() < 0) {
+			std::reverse(pFace + 1, pFaceEnd);
+		}
+	}
+}
+
+// Checks that edges have the base length, that every face is an outward-wound cycle of edges, and that every edge
+// borders exactly two faces
+template<u32 uVertCount, u32 uEdgeCount, u32 uFaceCount, u32 uFaceIndexCount>
+constexpr inline bool isTableValid(const SPhiPolyhedronTable<uVertCount, uEdgeCount, uFaceCount, uFaceIndexCount>& rTable) {
+	std::array<u32, uEdgeCount> edgeFaceCounts{};
+
+	for (u32 uEdge = 0; uEdge < uEdgeCount; ++uEdge) {
+		const std::pair<u32, u32>& rEdge = rTable.m_Edges[uEdge];
+
+		if (rEdge.first >= rEdge.second || rEdge.second >= uVertCount ||
+			(rTable.m_Vertices[rEdge.first] - rTable.m_Vertices[rEdge.second]).GetMagnitudeSquared() != g_kBaseEdgeLengthSquared) {
+			return false;
+		}
+	}
+
+	if (rTable.m_FaceOffsets[0] || rTable.m_FaceOffsets[uFaceCount] != uFaceIndexCount) {
+		return false;
+	}
+
+	for (u32 uFace = 0; uFace < uFaceCount; ++uFace) {
+		const u32 uFaceBegin = rTable.m_FaceOffsets[uFace];
+		const u32 uFaceEnd = rTable.m_FaceOffsets[uFace + 1];
+
+		if (uFaceEnd < uFaceBegin + 3) {
+			return false;
+		}
+
+		const CPhiVector3& rVert0 = rTable.m_Vertices[rTable.m_FaceIndices[uFaceBegin]];
+		const CPhiVector3 normal =
+			(rTable.m_Vertices[rTable.m_FaceIndices[uFaceBegin + 1]] - rVert0).Cross(
+			rTable.m_Vertices[rTable.m_FaceIndices[uFaceBegin + 2]] - rVert0);
+
+		if (normal.Dot(rVert0).GetSign() <= 0) {
+			return false;
+		}
+
+		for (u32 i = uFaceBegin; i < uFaceEnd; ++i) {
+			const u32 uVertA = rTable.m_FaceIndices[i];
+			const u32 uVertB = rTable.m_FaceIndices[i + 1 < uFaceEnd ? i + 1 : uFaceBegin];
+			const std::pair<u32, u32> edge(std::min(uVertA, uVertB), std::max(uVertA, uVertB));
+			u32 uEdge = 0;
+
+			while (uEdge < uEdgeCount && rTable.m_Edges[uEdge] != edge) {
+				++uEdge;
+			}
+
+			if (uEdge == uEdgeCount) {
+				return false;
+			}
+
+			++edgeFaceCounts[uEdge];
+		}
+	}
+
+	for (u32 uEdge = 0; uEdge < uEdgeCount; ++uEdge) {
+		if (edgeFaceCounts[uEdge] != 2) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+constexpr inline SIcosahedronTable generateIcosahedronTable() {
+	SIcosahedronTable table{};
+	const CPhiVector3 baseVector(CPhiVector(1, 0), CPhiVector(0, 1), CPhiVector(0, 0));
+
+	for (u32 i = 0; i < 3; ++i) {
+		for (u32 j = 0; j < 4; ++j) {
+			const CPhiVector3 reflectedVector(
+				baseVector.x * (j & 2 ? -1 : 1),
+				baseVector.y * (j & 1 ? -1 : 1),
+				baseVector.z);
+
+			table.m_Vertices[i * 4 + j] = CPhiVector3(
+				reflectedVector[(i    ) % 3],
+				reflectedVector[(i + 1) % 3],
+				reflectedVector[(i + 2) % 3]);
+		}
+	}
+
+	const std::array<CPhiVector3, 12>& rVerts = table.m_Vertices;
+	u32 uEdgeCount = 0;
+	u32 uFaceCount = 0;
+
+	for (u32 i = 0; i < 11; ++i) {
+		for (u32 j = i + 1; j < 12; ++j) {
+			if ((rVerts[i] - rVerts[j]).GetMagnitudeSquared() == g_kBaseEdgeLengthSquared) {
+				table.m_Edges[uEdgeCount++] = std::pair<u32, u32>(i, j);
+
+				for (u32 k = j + 1; k < 12; ++k) {
+					if ((rVerts[i] - rVerts[k]).GetMagnitudeSquared() == g_kBaseEdgeLengthSquared &&
+						(rVerts[j] - rVerts[k]).GetMagnitudeSquared() == g_kBaseEdgeLengthSquared) {
+						table.m_FaceOffsets[uFaceCount] = uFaceCount * 3;
+						table.m_FaceIndices[uFaceCount * 3    ] = i;
+						table.m_FaceIndices[uFaceCount * 3 + 1] = j;
+						table.m_FaceIndices[uFaceCount * 3 + 2] = k;
+						++uFaceCount;
+					}
+				}
+			}
+		}
+	}
+
+	table.m_FaceOffsets[uFaceCount] = uFaceCount * 3;
+	orientFacesOutward(table);
+
+	return table;
+}
+
+// The icosidodecahedron's vertices are the (doubled) midpoints of the icosahedron's edges
+constexpr inline SIcosidodecahedronTable generateIcosidodecahedronTable(const SIcosahedronTable& rIcosahedronTable) {
+	SIcosidodecahedronTable table{};
+	std::array<CPhiVector3, 30>& rVerts = table.m_Vertices;
+
+	for (u32 i = 0; i < 30; ++i) {
+		const std::pair<u32, u32>& rIcosaEdge = rIcosahedronTable.m_Edges[i];
+
+		rVerts[i] = rIcosahedronTable.m_Vertices[rIcosaEdge.first] + rIcosahedronTable.m_Vertices[rIcosaEdge.second];
+	}
+
+	std::array<u32, 30> edgeMap{};
+	u32 uEdgeCount = 0;
+
+	for (u32 i = 0; i < 29; ++i) {
+		for (u32 j = i + 1; j < 30; ++j) {
+			if ((rVerts[i] - rVerts[j]).GetMagnitudeSquared() == g_kBaseEdgeLengthSquared) {
+				table.m_Edges[uEdgeCount++] = std::pair<u32, u32>(i, j);
+				edgeMap[i] |= 1 << j;
+				edgeMap[j] |= 1 << i;
+			}
+		}
+	}
+
+	const CPhiVector acrossPhiVectorSquared(4, 4);
+	std::array<u32, 8> octants{};
+	u32 uFaceCount = 0;
+	u32 uFaceIndexCount = 0;
+	auto appendFace = [&](std::initializer_list<u32> face) {
+		table.m_FaceOffsets[uFaceCount++] = uFaceIndexCount;
+
+		for (u32 uVert : face) {
+			table.m_FaceIndices[uFaceIndexCount++] = uVert;
+		}
+	};
+
+	for (u32 i = 0; i < 30; ++i) {
+		const CPhiVector3& rVert = rVerts[i];
+
+		if (!rVert.x[0] && !rVert.y[0] && !rVert.z[0]) {
+			u32 aNeighbors[4] = {};
+			u32 uEdges = edgeMap[i];
+
+			// Unpack the adjacent vertex indices
+			for (u32 n = 0; n < 4; ++n) {
+				aNeighbors[n] = std::countr_zero(uEdges);
+				uEdges &= ~(1 << aNeighbors[n]);
+			}
+
+			// Make aNeighbors[0] and aNeighbors[1] be on the same pentagon (likewise with 2 and 3)
+			for (u32 n = 1; n < 4; ++n) {
+				if ((rVerts[aNeighbors[0]] - rVerts[aNeighbors[n]]).GetMagnitudeSquared() == acrossPhiVectorSquared) {
+					std::swap(aNeighbors[n], aNeighbors[1]);
+
+					break;
+				}
+			}
+
+			// Make aNeighbors[0] and aNeighbors[2] be on the same triangle (likewise with 1 and 3)
+			if ((rVerts[aNeighbors[0]] - rVerts[aNeighbors[2]]).GetMagnitudeSquared() != g_kBaseEdgeLengthSquared) {
+				std::swap(aNeighbors[2], aNeighbors[3]);
+			}
+
+			appendFace({i, aNeighbors[0], aNeighbors[2]});
+			appendFace({i, aNeighbors[1], aNeighbors[3]});
+
+			u32 aAcrosses[4] = {};
+
+			for (u32 n = 0; n < 4; ++n) {
+				u32 uNeighborEdges = edgeMap[aNeighbors[n]];
+
+				for (u32 a = 0; a < 4; ++a) {
+					u32 uAcross = std::countr_zero(uNeighborEdges);
+
+					if ((rVerts[i] - rVerts[uAcross]).GetMagnitudeSquared() == acrossPhiVectorSquared) {
+						aAcrosses[n] = uAcross;
+
+						break;
+					}
+
+					uNeighborEdges &= ~(1 << uAcross);
+				}
+			}
+
+			appendFace({i, aNeighbors[0], aAcrosses[0], aAcrosses[1], aNeighbors[1]});
+			appendFace({i, aNeighbors[2], aAcrosses[2], aAcrosses[3], aNeighbors[3]});
+		} else {
+			octants[
+				((rVert.x.GetSign() < 0)     ) |
+				((rVert.y.GetSign() < 0) << 1) |
+				((rVert.z.GetSign() < 0) << 2)] |= 1 << i;
+		}
+	}
+
+	for (u32 o = 0; o < 8; ++o) {
+		u32 aFace[3] = {};
+		u32 uOctant = octants[o];
+
+		// Unpack the octant vertex indices
+		for (u32 n = 0; n < 3; ++n) {
+			aFace[n] = std::countr_zero(uOctant);
+			uOctant &= ~(1 << aFace[n]);
+		}
+
+		appendFace({aFace[0], aFace[1], aFace[2]});
+	}
+
+	table.m_FaceOffsets[uFaceCount] = uFaceIndexCount;
+	orientFacesOutward(table);
+
+	return table;
+}
+
+// Variables
+constexpr const SIcosahedronTable		g_kIcosahedronTable			= generateIcosahedronTable();
+constexpr const SIcosidodecahedronTable	g_kIcosidodecahedronTable	= generateIcosidodecahedronTable(g_kIcosahedronTable);
+
+static_assert(isTableValid(g_kIcosahedronTable));
+static_assert(isTableValid(g_kIcosidodecahedronTable));
+
+#endif // __PHI_POLYHEDRON_TABLES__
\ No newline at end of file
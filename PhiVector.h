@@ -11,33 +11,168 @@
 
 #include "Defines.h"
 
+// Represents a + b * phi. Since phi^2 = phi + 1, every integer polynomial in phi reduces to this form, so values never
+// need more than two coefficients
 class CPhiVector {
 // Functions
 public:
-	CPhiVector();
-	CPhiVector(const std::vector<s32>& rVec);
-	CPhiVector(s32 sScalar);
+	constexpr CPhiVector();
+	CPhiVector(const std::vector<s32>& rVec);	// Coefficients of increasing powers of phi
+	constexpr CPhiVector(s32 sScalar);
+	constexpr CPhiVector(s32 sA, s32 sB);
+
+	constexpr	s32	GetSign			()	const;
+	constexpr	f64	GetF64			()	const;
+	constexpr	f64	GetF64ErrorBound()	const;
 
 	operator f32() const;
 
-	s32						operator[]	(u32 uIndex)					const;
-	CPhiVector				operator-	()								const;
-	CPhiVector				operator*	(const CPhiVector& rPhiVector)	const;
-	CPhiVector				operator*	(s32 sScalar)					const;
-	CPhiVector				operator+	(const CPhiVector& rPhiVector)	const;
-	CPhiVector				operator-	(const CPhiVector& rPhiVector)	const;
-	std::strong_ordering	operator<=>	(const CPhiVector& rPhiVector)	const;
-	CPhiVector&				operator*=	(const CPhiVector& rPhiVector);
-	CPhiVector&				operator*=	(s32 sScalar);
-	CPhiVector&				operator+=	(const CPhiVector& rPhiVector);
-	CPhiVector&				operator-=	(const CPhiVector& rPhiVector);
-
-	friend	CPhiVector		operator*	(s32 sScalar, const CPhiVector& rPhiVector);
-	friend	std::ostream&	operator<<	(std::ostream& rOStream, const CPhiVector& rPhiVector);
+	constexpr	s32						operator[]	(u32 uIndex)					const;
+	constexpr	CPhiVector				operator-	()								const;
+	constexpr	CPhiVector				operator*	(const CPhiVector& rPhiVector)	const;
+	constexpr	CPhiVector				operator*	(s32 sScalar)					const;
+	constexpr	CPhiVector				operator+	(const CPhiVector& rPhiVector)	const;
+	constexpr	CPhiVector				operator-	(const CPhiVector& rPhiVector)	const;
+	constexpr	bool					operator==	(const CPhiVector& rPhiVector)	const;
+	constexpr	std::strong_ordering	operator<=>	(const CPhiVector& rPhiVector)	const;
+	constexpr	CPhiVector&				operator*=	(const CPhiVector& rPhiVector);
+	constexpr	CPhiVector&				operator*=	(s32 sScalar);
+	constexpr	CPhiVector&				operator+=	(const CPhiVector& rPhiVector);
+	constexpr	CPhiVector&				operator-=	(const CPhiVector& rPhiVector);
+
+	friend	constexpr	CPhiVector		operator*	(s32 sScalar, const CPhiVector& rPhiVector);
+	friend				std::ostream&	operator<<	(std::ostream& rOStream, const CPhiVector& rPhiVector);
+
+private:
+	static constexpr s32 ComputeSign(s64 sA, s64 sB);
 
 // Variables
 private:
-	std::vector<s32> m_Vec;
+	s32 m_sA;
+	s32 m_sB;
 };
 
+// The a + b * phi form is unique, so hashing the coefficients is consistent with operator==
+template<>
+struct std::hash<CPhiVector> {
+	size_t operator()(const CPhiVector& rPhiVector) const noexcept;
+};
+
+// Functions (constexpr, so that base polyhedra can be generated at compile time)
+constexpr CPhiVector::CPhiVector() : m_sA(0), m_sB(0) {}
+
+constexpr CPhiVector::CPhiVector(s32 sScalar) : m_sA(sScalar), m_sB(0) {}
+
+constexpr CPhiVector::CPhiVector(s32 sA, s32 sB) : m_sA(sA), m_sB(sB) {}
+
+constexpr s32 CPhiVector::GetSign() const {
+	return ComputeSign(m_sA, m_sB);
+}
+
+constexpr f64 CPhiVector::GetF64() const {
+	return m_sA + m_sB * std::numbers::phi;
+}
+
+// Bounds |GetF64() - (a + b * phi)|: rounding phi, the product and the sum each cost at most half an ulp of the result
+constexpr f64 CPhiVector::GetF64ErrorBound() const {
+	return 0x1p-51 * (static_cast<f64>(m_sA < 0 ? -m_sA : m_sA) + 2.0 * static_cast<f64>(m_sB < 0 ? -m_sB : m_sB));
+}
+
+constexpr s32 CPhiVector::operator[](u32 uIndex) const {
+	return uIndex == 0 ? m_sA : uIndex == 1 ? m_sB : 0;
+}
+
+constexpr CPhiVector CPhiVector::operator-() const {
+	return CPhiVector(-m_sA, -m_sB);
+}
+
+constexpr CPhiVector CPhiVector::operator*(const CPhiVector& rPhiVector) const {
+	return CPhiVector(*this) *= rPhiVector;
+}
+
+constexpr CPhiVector CPhiVector::operator*(s32 sScalar) const {
+	return CPhiVector(*this) *= sScalar;
+}
+
+constexpr CPhiVector CPhiVector::operator+(const CPhiVector& rPhiVector) const {
+	return CPhiVector(*this) += rPhiVector;
+}
+
+constexpr CPhiVector CPhiVector::operator-(const CPhiVector& rPhiVector) const {
+	return CPhiVector(*this) -= rPhiVector;
+}
+
+constexpr bool CPhiVector::operator==(const CPhiVector& rPhiVector) const {
+	return m_sA == rPhiVector.m_sA && m_sB == rPhiVector.m_sB;
+}
+
+constexpr std::strong_ordering CPhiVector::operator<=>(const CPhiVector& rPhiVector) const {
+	return ComputeSign(
+		static_cast<s64>(m_sA) - rPhiVector.m_sA,
+		static_cast<s64>(m_sB) - rPhiVector.m_sB) <=> 0;
+}
+
+constexpr CPhiVector& CPhiVector::operator*=(const CPhiVector& rPhiVector) {
+	// (a + b * phi) * (c + d * phi) = (ac + bd) + (ad + bc + bd) * phi, since phi^2 = phi + 1
+	const s32 sBD = m_sB * rPhiVector.m_sB;
+
+	m_sB = m_sA * rPhiVector.m_sB + m_sB * rPhiVector.m_sA + sBD;
+	m_sA = m_sA * rPhiVector.m_sA + sBD;
+
+	return *this;
+}
+
+constexpr CPhiVector& CPhiVector::operator*=(s32 sScalar) {
+	m_sA *= sScalar;
+	m_sB *= sScalar;
+
+	return *this;
+}
+
+constexpr CPhiVector& CPhiVector::operator+=(const CPhiVector& rPhiVector) {
+	m_sA += rPhiVector.m_sA;
+	m_sB += rPhiVector.m_sB;
+
+	return *this;
+}
+
+constexpr CPhiVector& CPhiVector::operator-=(const CPhiVector& rPhiVector) {
+	m_sA -= rPhiVector.m_sA;
+	m_sB -= rPhiVector.m_sB;
+
+	return *this;
+}
+
+constexpr CPhiVector operator*(s32 sScalar, const CPhiVector& rPhiVector) {
+	return rPhiVector * sScalar;
+}
+
+// Exact for |sA|, |sB| <= 2^32, which covers the difference of any two CPhiVectors
+constexpr s32 CPhiVector::ComputeSign(s64 sA, s64 sB) {
+	const f64 fValue = sA + sB * std::numbers::phi;
+	const f64 fBand = 0x1p-40 * (static_cast<f64>(sA < 0 ? -sA : sA) + 2.0 * static_cast<f64>(sB < 0 ? -sB : sB));
+
+	// The f64 evaluation is off by a few ulps of the larger term at most, so its sign is trustworthy outside this band
+	if (fValue > fBand || fValue < -fBand) {
+		return fValue > 0.0 ? 1 : -1;
+	}
+
+	// 2 * (a + b * phi) = p + q * sqrt(5), where p = 2a + b and q = b
+	const s128 sP = 2 * static_cast<s128>(sA) + sB;
+	const s128 sQ = sB;
+	const s32 sSignP = (sP > 0) - (sP < 0);
+	const s32 sSignQ = (sQ > 0) - (sQ < 0);
+
+	if (sSignP == sSignQ || !sSignQ) {
+		return sSignP;
+	}
+
+	if (!sSignP) {
+		return sSignQ;
+	}
+
+	// The terms have opposite signs, so the larger magnitude wins. p^2 != 5q^2 since sqrt(5) is irrational
+	return sP * sP > 5 * sQ * sQ ? sSignP : sSignQ;
+}
+
 #endif // __PHI_VECTOR__
\ No newline at end of file
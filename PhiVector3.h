@@ -12,23 +12,27 @@ class CPhiVector;
 class CPhiVector3 {
 // Functions
 public:
-	CPhiVector3(const CPhiVector& rX, const CPhiVector& rY, const CPhiVector& rZ);
+	constexpr CPhiVector3();
+	constexpr CPhiVector3(const CPhiVector& rX, const CPhiVector& rY, const CPhiVector& rZ);
 
-	CPhiVector GetMagnitudeSquared() const;
+	constexpr	CPhiVector3	Cross				(const CPhiVector3& rPhiVector3)	const;
+	constexpr	CPhiVector	Dot					(const CPhiVector3& rPhiVector3)	const;
+	constexpr	CPhiVector	GetMagnitudeSquared	()									const;
 
-	const	CPhiVector&		operator[]	(u32 uIndex)						const;
-			CPhiVector&		operator[]	(u32 uIndex);
-			CPhiVector3		operator*	(const CPhiVector& rPhiVector)		const;
-			CPhiVector3		operator*	(s32 sScalar)						const;
-			CPhiVector3		operator+	(const CPhiVector3& rPhiVector3)	const;
-			CPhiVector3		operator-	(const CPhiVector3& rPhiVector3)	const;
-			CPhiVector3&	operator*=	(const CPhiVector& rPhiVector);
-			CPhiVector3&	operator*=	(s32 sScalar);
-			CPhiVector3&	operator+=	(const CPhiVector3& rPhiVector3);
-			CPhiVector3&	operator-=	(const CPhiVector3& rPhiVector3);
+	constexpr	const	CPhiVector&		operator[]	(u32 uIndex)						const;
+	constexpr			CPhiVector&		operator[]	(u32 uIndex);
+	constexpr			CPhiVector3		operator*	(const CPhiVector& rPhiVector)		const;
+	constexpr			CPhiVector3		operator*	(s32 sScalar)						const;
+	constexpr			CPhiVector3		operator+	(const CPhiVector3& rPhiVector3)	const;
+	constexpr			CPhiVector3		operator-	(const CPhiVector3& rPhiVector3)	const;
+	constexpr			CPhiVector3&	operator*=	(const CPhiVector& rPhiVector);
+	constexpr			CPhiVector3&	operator*=	(s32 sScalar);
+	constexpr			CPhiVector3&	operator+=	(const CPhiVector3& rPhiVector3);
+	constexpr			CPhiVector3&	operator-=	(const CPhiVector3& rPhiVector3);
+	constexpr			bool			operator==	(const CPhiVector3& rPhiVector3)	const;
 
-	friend	CPhiVector3		operator*	(s32 sScalar, const CPhiVector3& rPhiVector3);
-	friend	std::ostream&	operator<<	(std::ostream& rOStream, const CPhiVector3& rPhiVector3);
+	friend	constexpr	CPhiVector3		operator*	(s32 sScalar, const CPhiVector3& rPhiVector3);
+	friend				std::ostream&	operator<<	(std::ostream& rOStream, const CPhiVector3& rPhiVector3);
 
 // Variables
 public:
@@ -37,4 +41,120 @@ public:
 	CPhiVector	z;
 };
 
+template<>
+struct std::hash<CPhiVector3> {
+	size_t operator()(const CPhiVector3& rPhiVector3) const noexcept;
+};
+
+// Functions (constexpr, so that base polyhedra can be generated at compile time)
+constexpr CPhiVector3::CPhiVector3() {}
+
+constexpr CPhiVector3::CPhiVector3(const CPhiVector& rX, const CPhiVector& rY, const CPhiVector& rZ) :
+	x(rX), y(rY), z(rZ) {}
+
+constexpr CPhiVector3 CPhiVector3::Cross(const CPhiVector3& rPhiVector3) const {
+	return CPhiVector3(
+		y * rPhiVector3.z - rPhiVector3.y * z,
+		rPhiVector3.x * z - x * rPhiVector3.z,
+		x * rPhiVector3.y - rPhiVector3.x * y);
+}
+
+constexpr CPhiVector CPhiVector3::Dot(const CPhiVector3& rPhiVector3) const {
+	return x * rPhiVector3.x + y * rPhiVector3.y + z * rPhiVector3.z;
+}
+
+constexpr CPhiVector CPhiVector3::GetMagnitudeSquared() const {
+	return x * x + y * y + z * z;
+}
+
+constexpr const CPhiVector& CPhiVector3::operator[](u32 uIndex) const {
+	switch (uIndex) {
+	case 0:
+		return x;
+		break;
+	case 1:
+		return y;
+		break;
+	case 2:
+		return z;
+		break;
+	default:
+		return x;
+		break;
+	}
+}
+
+constexpr CPhiVector& CPhiVector3::operator[](u32 uIndex) {
+	switch (uIndex) {
+	case 0:
+		return x;
+		break;
+	case 1:
+		return y;
+		break;
+	case 2:
+		return z;
+		break;
+	default:
+		return x;
+		break;
+	}
+}
+
+constexpr CPhiVector3 CPhiVector3::operator*(const CPhiVector& rPhiVector) const {
+	return CPhiVector3(*this) *= rPhiVector;
+}
+
+constexpr CPhiVector3 CPhiVector3::operator*(s32 sScalar) const {
+	return CPhiVector3(*this) *= sScalar;
+}
+
+constexpr CPhiVector3 CPhiVector3::operator+(const CPhiVector3& rPhiVector3) const {
+	return CPhiVector3(*this) += rPhiVector3;
+}
+
+constexpr CPhiVector3 CPhiVector3::operator-(const CPhiVector3& rPhiVector3) const {
+	return CPhiVector3(*this) -= rPhiVector3;
+}
+
+constexpr CPhiVector3& CPhiVector3::operator*=(const CPhiVector& rPhiVector) {
+	x *= rPhiVector;
+	y *= rPhiVector;
+	z *= rPhiVector;
+
+	return *this;
+}
+
+constexpr CPhiVector3& CPhiVector3::operator*=(s32 sScalar) {
+	x *= sScalar;
+	y *= sScalar;
+	z *= sScalar;
+
+	return *this;
+}
+
+constexpr CPhiVector3& CPhiVector3::operator+=(const CPhiVector3& rPhiVector3) {
+	x += rPhiVector3.x;
+	y += rPhiVector3.y;
+	z += rPhiVector3.z;
+
+	return *this;
+}
+
+constexpr CPhiVector3& CPhiVector3::operator-=(const CPhiVector3& rPhiVector3) {
+	x -= rPhiVector3.x;
+	y -= rPhiVector3.y;
+	z -= rPhiVector3.z;
+
+	return *this;
+}
+
+constexpr bool CPhiVector3::operator==(const CPhiVector3& rPhiVector3) const {
+	return x == rPhiVector3.x && y == rPhiVector3.y && z == rPhiVector3.z;
+}
+
+constexpr CPhiVector3 operator*(s32 sScalar, const CPhiVector3& rPhiVector3) {
+	return rPhiVector3 * sScalar;
+}
+
 #endif // __PHI_VECTOR_3__
\ No newline at end of file
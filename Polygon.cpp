@@ -270,6 +270,7 @@ void CPolygon::Reset() {
 	m_LoopBoundaries.push_back(0);
 	m_IsLoopClockwise.clear();
 	m_bWereAnyNewLoopsAdded = false;
+	InvalidateLoopSlabs();
 }
 
 void CPolygon::Translate(const CVector2& rTranslation) {
@@ -281,6 +282,8 @@ void CPolygon::Translate(const CVector2& rTranslation) {
 		rExtrema.m_vMin += rTranslation;
 		rExtrema.m_vMax += rTranslation;
 	}
+
+	InvalidateLoopSlabs();
 }
 
 CPolygon& CPolygon::operator|=(CPolygon& rPoly2) {
@@ -336,6 +339,7 @@ CPolygon& CPolygon::operator|=(CPolygon& rPoly2) {
 		}
 
 		m_Vertices.insert(m_Vertices.end(), rPoly2.m_Vertices.begin(), rPoly2.m_Vertices.end());
+		InvalidateLoopSlabs();
 		m_Extrema.reserve(m_Extrema.size() + rPoly2.GetLoopCount());
 		m_Extrema.front().ReEvaluate(rPoly2.m_Extrema.front());
 
@@ -511,21 +515,121 @@ u32 CPolygon::GetPrevIndex(u32 uIndex) const {
 	return uIndex - 1;
 }
 
+const CPolygon::SLoopSlabs& CPolygon::GetLoopSlabs(u32 uLoopIndex) const {
+	if (m_LoopSlabs.size() != GetLoopCount()) {
+		m_LoopSlabs.clear();
+		m_LoopSlabs.resize(GetLoopCount());
+	}
+
+	SLoopSlabs& rSlabs = m_LoopSlabs[uLoopIndex];
+
+	if (rSlabs.IsBuilt()) {
+		return rSlabs;
+	}
+
+	const u32 uStartIndex = m_LoopBoundaries[uLoopIndex];
+	const u32 uStopIndex = m_LoopBoundaries[uLoopIndex + 1];
+
+	// Pad each edge's y extent by more than CExtrema::OverlapsWithExtrema() does, so that rounding can only ever add
+	// edges to a slab, never drop one that CVector2::DoLineSegmentsIntersect() would've counted
+	#if ROUND
+		const f32 fPadding = 2.0f * g_kfEpsilon;
+	#else // ROUND
+		const f32 fPadding = 0.0f;
+	#endif // ROUND
+
+	auto GetEdgeExtentLambda = [this, uStartIndex, uStopIndex, fPadding](u32 uIndex) -> std::pair<f32, f32> {
+		const f32 fY1 = m_Vertices[uIndex].y;
+		const f32 fY2 = m_Vertices[uIndex + 1 == uStopIndex ? uStartIndex : uIndex + 1].y;
+
+		return { std::min(fY1, fY2) - fPadding, std::max(fY1, fY2) + fPadding };
+	};
+
+	std::vector<f32>& rBoundaries = rSlabs.m_Boundaries;
+
+	rBoundaries.reserve((uStopIndex - uStartIndex) << 1);
+
+	for (u32 uIndex = uStartIndex; uIndex < uStopIndex; ++uIndex) {
+		const std::pair<f32, f32> edgeExtent = GetEdgeExtentLambda(uIndex);
+
+		rBoundaries.push_back(edgeExtent.first);
+		rBoundaries.push_back(edgeExtent.second);
+	}
+
+	std::sort(rBoundaries.begin(), rBoundaries.end());
+	rBoundaries.erase(std::unique(rBoundaries.begin(), rBoundaries.end()), rBoundaries.end());
+
+	// An edge is listed under every slab whose lower bound lies within the edge's extent. Count, then fill.
+	auto ForEachEdgeSlabLambda = [this, &rBoundaries, &GetEdgeExtentLambda, uStartIndex, uStopIndex](auto&& rrFunc) -> void {
+		for (u32 uIndex = uStartIndex; uIndex < uStopIndex; ++uIndex) {
+			const std::pair<f32, f32> edgeExtent = GetEdgeExtentLambda(uIndex);
+			const u32 uFirstSlab = std::lower_bound(rBoundaries.begin(), rBoundaries.end(), edgeExtent.first) - rBoundaries.begin();
+			const u32 uLastSlab = std::lower_bound(rBoundaries.begin(), rBoundaries.end(), edgeExtent.second) - rBoundaries.begin();
+
+			for (u32 uSlab = uFirstSlab; uSlab <= uLastSlab; ++uSlab) {
+				rrFunc(uSlab, uIndex);
+			}
+		}
+	};
+
+	std::vector<u32>& rSlabOffsets = rSlabs.m_SlabOffsets;
+
+	rSlabOffsets.assign(rBoundaries.size() + 1, 0);
+	ForEachEdgeSlabLambda([&rSlabOffsets](u32 uSlab, u32) -> void {
+		++rSlabOffsets[uSlab + 1];
+	});
+
+	for (u32 uSlab = 1; uSlab < rSlabOffsets.size(); ++uSlab) {
+		rSlabOffsets[uSlab] += rSlabOffsets[uSlab - 1];
+	}
+
+	std::vector<u32> slabFillCounts(rSlabOffsets.begin(), rSlabOffsets.end() - 1);
+
+	rSlabs.m_EdgeIndices.resize(rSlabOffsets.back());
+	ForEachEdgeSlabLambda([&rSlabs, &slabFillCounts](u32 uSlab, u32 uIndex) -> void {
+		rSlabs.m_EdgeIndices[slabFillCounts[uSlab]++] = uIndex;
+	});
+
+	return rSlabs;
+}
+
 bool CPolygon::HasPointInsideLoop(const CVector2& rPoint, u32 uLoopIndex) const {
 	if (!m_Extrema[uLoopIndex + 1].ContainsPoint(rPoint)) {
 		return false;
 	}
 
 	const CVector2 outsidePoint(m_Extrema[uLoopIndex + 1].m_vMin.x - 1.0f, rPoint.y);
+	const u32 uStartIndex = m_LoopBoundaries[uLoopIndex];
+	const u32 uStopIndex = m_LoopBoundaries[uLoopIndex + 1];
 	bool bIntersectedOddly = false;
 
-	for (u32 uIndex = m_LoopBoundaries[uLoopIndex], uStopIndex = m_LoopBoundaries[uLoopIndex + 1]; uIndex < uStopIndex; ++uIndex) {
-		bIntersectedOddly ^= CVector2::DoLineSegmentsIntersect(
+	auto DoesRayIntersectEdgeLambda = [this, &outsidePoint, &rPoint, uStartIndex, uStopIndex](u32 uIndex) -> bool {
+		return CVector2::DoLineSegmentsIntersect(
 			outsidePoint,
 			rPoint,
 			m_Vertices[uIndex],
-			m_Vertices[uIndex + 1 == uStopIndex ? m_LoopBoundaries[uLoopIndex] : uIndex + 1],
+			m_Vertices[uIndex + 1 == uStopIndex ? uStartIndex : uIndex + 1],
 			true);
+	};
+
+	if (uStopIndex - uStartIndex < kuMinSlabLoopSize) {
+		for (u32 uIndex = uStartIndex; uIndex < uStopIndex; ++uIndex) {
+			bIntersectedOddly ^= DoesRayIntersectEdgeLambda(uIndex);
+		}
+
+		return bIntersectedOddly;
+	}
+
+	// Only the edges in the point's slab can possibly cross the ray, so the rest of the loop is skipped
+	const SLoopSlabs& rSlabs = GetLoopSlabs(uLoopIndex);
+	const u32 uSlab = std::upper_bound(rSlabs.m_Boundaries.begin(), rSlabs.m_Boundaries.end(), rPoint.y) - rSlabs.m_Boundaries.begin();
+
+	if (!uSlab) {
+		return false;
+	}
+
+	for (u32 uEdge = rSlabs.m_SlabOffsets[uSlab - 1]; uEdge < rSlabs.m_SlabOffsets[uSlab]; ++uEdge) {
+		bIntersectedOddly ^= DoesRayIntersectEdgeLambda(rSlabs.m_EdgeIndices[uEdge]);
 	}
 
 	return bIntersectedOddly;
@@ -648,6 +752,7 @@ void CPolygon::RemoveConsecutiveEquivalentVertices() {
 
 	std::swap(m_Vertices, oldVerts);
 	std::swap(m_LoopBoundaries, oldLoopBoundaries);
+	InvalidateLoopSlabs();
 
 	for (u32 uCurrVertIndex = 0, uLoopIndex = 0, uLoopBeginIndex, uLoopEndIndex = 0; uCurrVertIndex < oldVerts.size(); ++uCurrVertIndex) {
 		if (uCurrVertIndex == uLoopEndIndex) {
@@ -700,6 +805,7 @@ void CPolygon::RemoveConsecutiveColinearVertices() {
 
 			std::swap(m_Vertices, oldVertices);
 			std::swap(m_LoopBoundaries, oldLoopBoundaries);
+			InvalidateLoopSlabs();
 
 			for (u32 uVert = 0, uLoopIndex = 0, uVTRIndex = 0; uVert < oldVertices.size(); ++uVert) {
 				if (uVert == oldLoopBoundaries[uLoopIndex]) {
@@ -1398,6 +1504,8 @@ void CPolygon::VerifyVerticesAreClockwise(u32 uLoopIndex /* = u32_MAX */) {
 		for (u32 uVertIndexA = uBeginLoopIndex, uVertIndexB = uEndLoopIndex - 1; uVertIndexA < uEndVertsToSwapIndex; ++uVertIndexA, --uVertIndexB) {
 			std::swap(m_Vertices[uVertIndexA], m_Vertices[uVertIndexB]);
 		}
+
+		InvalidateLoopSlabs();
 	}
 }
 
@@ -2432,4 +2540,5 @@ bool CPolygon::AreLoopsEqual(const CPolygon& rPoly1, const CPolygon& rPoly2, u32
 }
 
 const	char*	CPolygon::sm_aOriginStrings[EOrigin::Count]	= { "Poly1", "Poly2", "Xings", "Ghost", "OldP1", "OldP2" };
-const	f32		CPolygon::kfTau								= 2 * std::numbers::pi_v<f32>;
\ No newline at end of file
+const	f32		CPolygon::kfTau								= 2 * std::numbers::pi_v<f32>;
+const	u32		CPolygon::kuMinSlabLoopSize					= 16;
\ No newline at end of file
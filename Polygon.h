@@ -82,6 +82,20 @@ class CPolygon {
 				SOldPolyLoopData* m_pOldPolyLoopData;
 		};
 
+		// Splits a loop into horizontal slabs bounded by the (padded) y extents of its edges, such that any edge a
+		// horizontal ray within a slab could intersect is listed under that slab
+		struct SLoopSlabs {
+			// Functions
+			public:
+				bool IsBuilt() const { return !m_Boundaries.empty(); }
+
+			// Variables
+			public:
+				std::vector<f32>	m_Boundaries;	// Sorted, unique slab lower bounds
+				std::vector<u32>	m_SlabOffsets;	// Slab i's edges are m_EdgeIndices[m_SlabOffsets[i], m_SlabOffsets[i + 1])
+				std::vector<u32>	m_EdgeIndices;	// Index of each edge's first vertex
+		};
+
 	// Functions
 	public:
 		CPolygon();
@@ -107,8 +121,10 @@ class CPolygon {
 		u32		GetLoopIndex						(u32 uIndex)								const;
 		u32		GetNextIndex						(u32 uIndex)								const;
 		u32		GetPrevIndex						(u32 uIndex)								const;
+		const	SLoopSlabs&	GetLoopSlabs			(u32 uLoopIndex)							const;
 		bool	HasPointInsideLoop					(const CVector2& rPoint, u32 uLoopIndex)	const;
 		void	InitializeLoopTrackers				();
+		void	InvalidateLoopSlabs					()											{ m_LoopSlabs.clear(); }
 		void	Rectify								(SLoopOriginData* pLoopOriginData = nullptr);
 		void	RemoveConsecutiveEquivalentVertices	();
 		void	RemoveConsecutiveColinearVertices	();
@@ -131,10 +147,14 @@ class CPolygon {
 		std::vector<bool>		m_IsLoopClockwise;
 		bool					m_bWereAnyNewLoopsAdded;
 
+		// Built lazily by HasPointInsideLoop() for large loops, and cleared whenever vertices or loops change
+		mutable	std::vector<SLoopSlabs>	m_LoopSlabs;
+
 		static const char* sm_aOriginStrings[EOrigin::Count];
 	// Constants
 	private:
 		static const f32 kfTau;
+		static const u32 kuMinSlabLoopSize;
 };
 
 #endif // __POLYGON__
\ No newline at end of file
@@ -1,15 +1,26 @@
+#include <algorithm>
 #include <cmath>
 #include <chrono>
-#include <float.h>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <numeric>
+#include <sstream>
 
 #include "Polyhedron.h"
 
+#include "DeflateStream.h"
+#include "FaceStream.h"
+#include "GeometryFile.h"
 #include "Logging.h"
+#include "Parallel.h"
+#include "PhiFractal.h"
 #include "PhiPolyhedron.h"
 #include "PhiVector3.h"
+#include "RadixSort.h"
 #include "Svg.h"
+#include "SvgWriter.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
@@ -19,6 +30,16 @@
 
 using namespace NLog;
 
+// Version 1 of the CPolyhedron layout
+constexpr const u64 g_kuGeometryFormat = 0x0000000200000001ull;
+
+// Faces formatted per thread before the batch is written out
+constexpr const u64 g_kuSvgChunkFaceCount = 1 << 14;
+
+// Rotations that bring a 3-fold (about y) or 5-fold (about x) symmetry axis to face the viewer
+constexpr const f64 g_kd3FoldSymmetryCos = 0.93417235896271570, g_kd3FoldSymmetrySin = 0.35682208977308993;
+constexpr const f64 g_kd5FoldSymmetryCos = 0.85065080835203993, g_kd5FoldSymmetrySin = 0.52573111211913361;
+
 #if DBG_PH_PVF
 u32 CPolyhedron::sm_uMaskLevel = 0;
 #if !DBG_PH_PVF_SVG
@@ -76,19 +97,26 @@ std::ostream& operator<<(std::ostream& os, std::chrono::nanoseconds ns) {
 
 CPolyhedron::CPolyhedron() {}
 
-CPolyhedron::CPolyhedron(const CPhiPolyhedron& rPhiPolyhedron) : m_Edges(rPhiPolyhedron.m_Edges), m_Faces(rPhiPolyhedron.m_Faces) {
-	const std::vector<CPhiVector3>& rVerts = rPhiPolyhedron.m_Vertices;
+CPolyhedron::CPolyhedron(const CPhiPolyhedron& rPhiPolyhedron, EPerspective ePerspective) :
+	m_Edges(rPhiPolyhedron.m_Edges),
+	m_Faces(rPhiPolyhedron.m_Faces),
+	m_VertexLevels(rPhiPolyhedron.m_VertexLevels),
+	m_EdgeLevels(rPhiPolyhedron.m_EdgeLevels),
+	m_FaceLevels(rPhiPolyhedron.m_FaceLevels) {
 
-	for (u32 i = 0; i < rVerts.size(); ++i) {
-		m_Vertices.emplace_back(rVerts[i]);
-	}
+	ProjectVertices(rPhiPolyhedron, ePerspective);
 }
 
 CPolyhedron& CPolyhedron::Focus3FoldSymmetry() {
-	const f32 C = 0.93417235896271570f, S = 0.35682208977308993f;
+	const f32 C = g_kd3FoldSymmetryCos, S = g_kd3FoldSymmetrySin;
 
-	for (u32 v = 0; v < m_Vertices.size(); ++v) {
+	for (u64 v = 0; v < m_Vertices.size(); ++v) {
 		CVector3& rVert = m_Vertices[v];
+
+		if (m_VertexErrors.size()) {
+			m_VertexErrors[v] = (C + S) * m_VertexErrors[v] + 0x1p-22f * (std::abs(rVert.x) + std::abs(rVert.z));
+		}
+
 		const f32 fNewX =  C * rVert.x + S * rVert.z;
 		const f32 fNewZ = -S * rVert.x + C * rVert.z;
 		rVert.x = fNewX;
@@ -99,10 +127,15 @@ CPolyhedron& CPolyhedron::Focus3FoldSymmetry() {
 }
 
 CPolyhedron& CPolyhedron::Focus5FoldSymmetry() {
-	const f32 C = 0.85065080835203993f, S = 0.52573111211913361f;
+	const f32 C = g_kd5FoldSymmetryCos, S = g_kd5FoldSymmetrySin;
 
-	for (u32 i = 0; i < m_Vertices.size(); ++i) {
+	for (u64 i = 0; i < m_Vertices.size(); ++i) {
 		CVector3& rVert = m_Vertices[i];
+
+		if (m_VertexErrors.size()) {
+			m_VertexErrors[i] = (C + S) * m_VertexErrors[i] + 0x1p-22f * (std::abs(rVert.y) + std::abs(rVert.z));
+		}
+
 		const f32 fNewY = C * rVert.y - S * rVert.z;
 		const f32 fNewZ = S * rVert.y + C * rVert.z;
 		rVert.y = fNewY;
@@ -112,319 +145,626 @@ CPolyhedron& CPolyhedron::Focus5FoldSymmetry() {
 	return *this;
 }
 
-bool CPolyhedron::SaveToSvg(std::string fileName, u32 uPrintFlags) const {
-	if (!(uPrintFlags & (Verts | Edges | Faces))) {
-		return false;
-	}
+// Replaces m_Vertices with rPhiPolyhedron's vertices as seen from ePerspective, leaving the edges and faces alone
+void CPolyhedron::ProjectVertices(const CPhiPolyhedron& rPhiPolyhedron, EPerspective ePerspective) {
+	u32 uRotatedAxis;
+	f64 dCos;
+	f64 dSin;
+
+	ComputeViewRotation(ePerspective, uRotatedAxis, dCos, dSin);
+
+	m_Vertices.resize(rPhiPolyhedron.m_Vertices.size());
+	m_VertexErrors.resize(rPhiPolyhedron.m_Vertices.size());
+
+	parallelFor(m_Vertices.size(), [&](u64 uBegin, u64 uEnd) {
+		// Convert in cache-sized blocks, so the SoA buffers are reused instead of spanning every vertex
+		constexpr u64 kuBlockSize = 1 << 12;
+		CPhiPolyhedron::SVertexCoordinates vertexCoordinates;
+
+		for (u64 uBlockBegin = uBegin; uBlockBegin < uEnd; uBlockBegin += kuBlockSize) {
+			const u64 uBlockSize = std::min(uEnd - uBlockBegin, kuBlockSize);
+
+			rPhiPolyhedron.PopulateVertexCoordinates(vertexCoordinates, uBlockBegin, uBlockBegin + uBlockSize);
+
+			f64* pX = vertexCoordinates.m_Coordinates[0].data();
+			f64* pY = vertexCoordinates.m_Coordinates[1].data();
+			f64* pZ = vertexCoordinates.m_Coordinates[2].data();
+			f64* pU = vertexCoordinates.m_Coordinates[uRotatedAxis].data();
+			f64* pErrorBounds = vertexCoordinates.m_ErrorBounds.data();
+
+			for (u64 v = 0; v < uBlockSize; ++v) {
+				const f64 dU = pU[v];
+				const f64 dZ = pZ[v];
+
+				pU[v] = dCos * dU + dSin * dZ;
+				pZ[v] = -dSin * dU + dCos * dZ;
 
-	f32 dMinX = FLT_MAX, dMinY = FLT_MAX, dMaxX = -FLT_MAX, dMaxY = -FLT_MAX;
+				// |cos| + |sin| <= sqrt(2) amplifies the conversion error, and the rotation itself rounds a few times
+				pErrorBounds[v] = 1.5 * pErrorBounds[v] + 0x1p-50 * (std::abs(dU) + std::abs(dZ));
+			}
+
+			for (u64 v = 0; v < uBlockSize; ++v) {
+				m_Vertices[uBlockBegin + v] = CVector3(static_cast<f32>(pX[v]), static_cast<f32>(pY[v]), static_cast<f32>(pZ[v]));
+
+				// Rounding to f32 costs at most half an ulp, which is at most 2^-24 of the magnitude. The bound itself is
+				// padded by 2^-20 first, so that rounding it to f32 can't make it smaller than it should be
+				m_VertexErrors[uBlockBegin + v] = static_cast<f32>((1.0 + 0x1p-20) * (pErrorBounds[v] + 0x1p-24 * std::max({
+					std::abs(pX[v]),
+					std::abs(pY[v]),
+					std::abs(pZ[v]) })));
+			}
+		}
+	});
+}
 
-	for (u32 i = 0; i < m_Vertices.size(); ++i) {
-		const CVector3& rVert = m_Vertices[i];
+// Loads geometry saved by SaveGeometry() under the same key, leaving this empty if the file is missing or invalid
+bool CPolyhedron::LoadGeometry(const std::string& rFileName, u64 uKey) {
+	CGeometryFile file;
 
-		dMinX = std::min(dMinX, rVert.x);
-		dMinY = std::min(dMinY, rVert.y);
-		dMaxX = std::max(dMaxX, rVert.x);
-		dMaxY = std::max(dMaxY, rVert.y);
+	if (!(file.Map(rFileName, g_kuGeometryFormat, uKey) &&
+		file.CopyArray(0, m_Vertices) &&
+		file.CopyArray(1, m_Edges) &&
+		m_Faces.CopyArrays(file, 2) &&
+		file.CopyArray(4, m_VertexErrors) &&
+		file.CopyArray(5, m_VertexLevels) &&
+		file.CopyArray(6, m_EdgeLevels) &&
+		file.CopyArray(7, m_FaceLevels))) {
+
+		*this = CPolyhedron();
+
+		return false;
 	}
 
-	s32 sMinX = dMinX, sMinY = dMinY, sMaxX = dMaxX, sMaxY = dMaxY;
+	return true;
+}
 
-	sMinY = sMinY * 2;
-	sMaxX = sMaxX * 2;
-	sMinX = sMinX * 2;
-	sMaxY = sMaxY * 2;
+bool CPolyhedron::SaveGeometry(const std::string& rFileName, u64 uKey) const {
+	std::vector<std::span<const u8>> arrays = { CGeometryFile::GetBytes(m_Vertices), CGeometryFile::GetBytes(m_Edges) };
 
-	std::ofstream file(fileName.c_str(), std::ios_base::trunc);
+	m_Faces.AppendArrays(arrays);
+	arrays.push_back(CGeometryFile::GetBytes(m_VertexErrors));
+	arrays.push_back(CGeometryFile::GetBytes(m_VertexLevels));
+	arrays.push_back(CGeometryFile::GetBytes(m_EdgeLevels));
+	arrays.push_back(CGeometryFile::GetBytes(m_FaceLevels));
 
-	if (!file.is_open()) {
+	return CGeometryFile::Save(rFileName, g_kuGeometryFormat, uKey, arrays);
+}
+
+// Writes a pyramid of depth-ordered tiles, each its own SVG: level z splits the view box's larger side into 2^z, and the
+// tile in its column x and row y is saved as rDirectoryName/z/x_y.svg. A tile holds every face SaveToSvg() would paint
+// whose extrema overlap it, in the same order, except that of the faces smaller than one of its pixels (uTileResolution
+// to a side), only the last painted over each pixel is kept
+bool CPolyhedron::SaveTilesToSvg(const std::string& rDirectoryName, u32 uLevelCount, u32 uPrintFlags, u32 uTileResolution, u32 uSignificantDigits) const {
+	// A level's tile count per side, 1 << uLevel, has to fit in a u32
+	if (!(uPrintFlags & Faces) || uLevelCount > 31) {
 		return false;
 	}
 
-	file << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"" <<
-		sMinX << ' ' << sMinY << ' ' << sMaxX - sMinX << ' ' << sMaxY - sMinY << "\">\n" <<
-		std::fixed << std::setprecision(5) << std::setfill('0');
+	CExtrema extrema;
 
-	if (uPrintFlags & Depth && uPrintFlags & Faces) {
-		std::vector<u32> faceIndices(m_Faces.size(), 0);
-		std::unordered_map<u64, u32> inverseEdges;
-		std::unordered_set<u32> visibleFaces;
+	for (u64 i = 0; i < m_Vertices.size(); ++i) {
+		extrema.ReEvaluate(m_Vertices[i]);
+	}
 
-		SortFaceIndicesByHeight(faceIndices);
-		PopulateInverseEdges(inverseEdges);
+	s32 sMinX, sMinY, sWidth, sHeight;
 
-		if (uPrintFlags & CullHiddenFaces) {
-			PopulateVisibleFaces(fileName, faceIndices, visibleFaces);
+	ComputeViewBox(extrema, sMinX, sMinY, sWidth, sHeight);
+
+	const f32 fPyramidSize = std::max(std::max(sWidth, sHeight), 1);
+
+	// Edges' strokes and vertices' circles reach past their faces' extrema
+	const f32 fMargin = uPrintFlags & Verts ? 0.0625f : uPrintFlags & Edges ? 0.015625f : 0.0f;
+	CMappedVector<SFaceAttributes> faceAttributes;
+	CMappedVector<u32> faceIndices;
+	CMappedVector<u8> visibleFaces;
+	CMappedVector<u32> sideEdges;
+	CMappedVector<u8> sideFlags;
+	CMappedVector<u32> paintedFaceIndices;
+
+	PopulateFaceAttributes(faceAttributes);
+	SortFaceIndicesByHeight(faceAttributes, faceIndices);
+
+	if (uPrintFlags & CullHiddenFaces) {
+		PopulateVisibleFaces(rDirectoryName, faceAttributes, faceIndices, visibleFaces);
+	}
+
+	m_Faces.PopulateSideEdges(m_Edges, sideEdges);
+	PopulateSideFlags(faceIndices, visibleFaces, sideEdges, sideFlags);
+
+	for (u32 uFaceIndex : faceIndices) {
+		if (!visibleFaces.size() || visibleFaces[uFaceIndex]) {
+			paintedFaceIndices.push_back(uFaceIndex);
 		}
+	}
 
-		for (u32 fi = 0; fi < faceIndices.size(); ++fi) {
-			const u32 uFaceIndex = faceIndices[fi];
+	const auto computeCell = [](f32 fOffset, f32 fCellSize, u32 uCellCount) {
+		return static_cast<u32>(std::clamp<f32>(std::floor(fOffset / fCellSize), 0.0f, uCellCount - 1.0f));
+	};
+
+	// Each level's faces are bucketed by the rows of tiles they overlap, keeping their painting order, so a row only visits
+	// its own faces rather than all of them
+	std::vector<std::vector<u64>> levelRowOffsets(uLevelCount);
+	std::vector<std::vector<u32>> levelRowFaceIndices(uLevelCount);
+
+	parallelFor(uLevelCount, [&](u64 uBegin, u64 uEnd) {
+		for (u64 uLevel = uBegin; uLevel < uEnd; ++uLevel) {
+			const u32 uTileCount = 1u << uLevel;	// Per side
+			const f32 fTileSize = fPyramidSize / uTileCount;
+			std::vector<u64>& rRowOffsets = levelRowOffsets[uLevel];
+			std::vector<u32>& rRowFaceIndices = levelRowFaceIndices[uLevel];
+			const auto forEachRow = [&](u32 uFaceIndex, const auto& rFunc) {
+				const CExtrema& rExtrema = faceAttributes[uFaceIndex].m_Extrema;
+				const u32 uLastRow = computeCell(rExtrema.m_vMax.y + fMargin - sMinY, fTileSize, uTileCount);
+
+				for (u32 uRow = computeCell(rExtrema.m_vMin.y - fMargin - sMinY, fTileSize, uTileCount); uRow <= uLastRow; ++uRow) {
+					rFunc(uRow);
+				}
+			};
 
-			if (uPrintFlags & CullHiddenFaces && !visibleFaces.contains(uFaceIndex)) {
-				#if DBG_PH_STS
-					std::cout << "Culling face " << uFaceIndex << std::endl;
-				#endif // DBG_PH_STS
+			rRowOffsets.assign(uTileCount + 1, 0);
 
-				continue;
+			for (u32 uFaceIndex : paintedFaceIndices) {
+				forEachRow(uFaceIndex, [&](u32 uRow) { ++rRowOffsets[uRow + 1]; });
 			}
 
-			const std::vector<u32>& rFace = m_Faces[uFaceIndex];
+			std::partial_sum(rRowOffsets.begin(), rRowOffsets.end(), rRowOffsets.begin());
+			rRowFaceIndices.resize(rRowOffsets.back());
 
-			if (!rFace.size()) {
-				continue;
+			std::vector<u64> nextPositions(rRowOffsets.begin(), rRowOffsets.end() - 1);
+
+			for (u32 uFaceIndex : paintedFaceIndices) {
+				forEachRow(uFaceIndex, [&](u32 uRow) { rRowFaceIndices[nextPositions[uRow]++] = uFaceIndex; });
 			}
+		}
+	}, 1);
 
-			const CVector3& rVert0 = m_Vertices[rFace[0]];
+	// Each row of each level's tiles is binned and written on its own
+	std::vector<std::pair<u32, u32>> rows;
 
-			file << "<path fill=\"#" << std::hex << std::setw(6) << ComputeRGBA(uPrintFlags, uFaceIndex) << std::dec << "\" d=\"M " << rVert0.x << ' ' << rVert0.y;
+	for (u32 uLevel = 0; uLevel < uLevelCount; ++uLevel) {
+		std::error_code errorCode;
 
-			for (u32 fv = 1; fv < rFace.size(); ++fv) {
-				const CVector3& rVert = m_Vertices[rFace[fv]];
+		std::filesystem::create_directories(rDirectoryName + '/' + std::to_string(uLevel), errorCode);
+
+		if (errorCode) {
+			return false;
+		}
 
-				file << " L " << rVert.x << ' ' << rVert.y;
+		for (u32 uRow = 0; uRow < 1u << uLevel; ++uRow) {
+			rows.emplace_back(uLevel, uRow);
+		}
+	}
+
+	std::vector<u8> savedRows(rows.size(), false);
+
+	parallelFor(rows.size(), [&](u64 uBegin, u64 uEnd) {
+		std::vector<std::vector<u32>> tileFaceIndices;
+		std::vector<std::pair<u64, u32>> subPixelFaces;	// Pixel, then position in the tile
+		std::vector<u8> keptFaces;
+
+		for (u64 r = uBegin; r < uEnd; ++r) {
+			const u32 uLevel = rows[r].first;
+			const u32 uRow = rows[r].second;
+			const u32 uTileCount = 1u << uLevel;	// Per side
+			const f32 fTileSize = fPyramidSize / uTileCount;
+			const f32 fPixelSize = fTileSize / uTileResolution;
+			const f32 fTileMinY = sMinY + uRow * fTileSize;
+			const std::vector<u32>& rRowFaceIndices = levelRowFaceIndices[uLevel];
+
+			tileFaceIndices.resize(uTileCount);
+
+			for (std::vector<u32>& rFaceIndices : tileFaceIndices) {
+				rFaceIndices.clear();
 			}
 
-			file << " Z\"/>\n";
+			for (u64 rf = levelRowOffsets[uLevel][uRow]; rf < levelRowOffsets[uLevel][uRow + 1]; ++rf) {
+				const u32 uFaceIndex = rRowFaceIndices[rf];
+				const CExtrema& rExtrema = faceAttributes[uFaceIndex].m_Extrema;
+				const u32 uLastColumn = computeCell(rExtrema.m_vMax.x + fMargin - sMinX, fTileSize, uTileCount);
+
+				for (u32 uColumn = computeCell(rExtrema.m_vMin.x - fMargin - sMinX, fTileSize, uTileCount); uColumn <= uLastColumn; ++uColumn) {
+					tileFaceIndices[uColumn].push_back(uFaceIndex);
+				}
+			}
 
-			if (uPrintFlags & Edges) {
-				file << "<g fill=\"none\" stroke-width=\"0.03125\" stroke-linecap=\"round\">\n";
+			savedRows[r] = true;
 
-				for (u32 fv = 0; fv < rFace.size(); ++fv) {
-					u32 uVertIndex1 = rFace[fv];
-					u32 uVertIndex2 = rFace[(fv + 1) % rFace.size()];
+			for (u32 uColumn = 0; uColumn < uTileCount; ++uColumn) {
+				const std::vector<u32>& rFaceIndices = tileFaceIndices[uColumn];
+				const f32 fTileMinX = sMinX + uColumn * fTileSize;
 
-					if (uVertIndex1 > uVertIndex2) {
-						std::swap(uVertIndex1, uVertIndex2);
+				// Of the faces smaller than a pixel, only the last painted over each pixel is kept, standing in for the rest
+				subPixelFaces.clear();
+				keptFaces.assign(rFaceIndices.size(), true);
+
+				for (u32 fi = 0; fi < rFaceIndices.size(); ++fi) {
+					const CExtrema& rExtrema = faceAttributes[rFaceIndices[fi]].m_Extrema;
+
+					if (std::max(rExtrema.m_vMax.x - rExtrema.m_vMin.x, rExtrema.m_vMax.y - rExtrema.m_vMin.y) < fPixelSize) {
+						const u32 uPixelX = computeCell(0.5f * (rExtrema.m_vMin.x + rExtrema.m_vMax.x) - fTileMinX, fPixelSize, uTileResolution);
+						const u32 uPixelY = computeCell(0.5f * (rExtrema.m_vMin.y + rExtrema.m_vMax.y) - fTileMinY, fPixelSize, uTileResolution);
+
+						subPixelFaces.emplace_back(static_cast<u64>(uPixelY) * uTileResolution + uPixelX, fi);
 					}
+				}
+
+				std::sort(subPixelFaces.begin(), subPixelFaces.end());
 
-					const u32 uEdgeIndex = inverseEdges[static_cast<u64>(uVertIndex1) + (static_cast<u64>(uVertIndex2) << 32)];
+				for (u64 sp = 0; sp + 1 < subPixelFaces.size(); ++sp) {
+					if (subPixelFaces[sp].first == subPixelFaces[sp + 1].first) {
+						keptFaces[subPixelFaces[sp].second] = false;
+					}
+				}
 
-					file << "<path stroke=\"#" << std::hex << std::setw(6) << ComputeRGB(uPrintFlags, Edges, uEdgeIndex) << std::dec << "\"";
+				std::ofstream file(rDirectoryName + '/' + std::to_string(uLevel) + '/' + std::to_string(uColumn) + '_' + std::to_string(uRow) + ".svg",
+					std::ios_base::trunc);
 
-					const CVector3& rVert1 = m_Vertices[uVertIndex1];
-					const CVector3& rVert2 = m_Vertices[uVertIndex2];
+				if (!file.is_open()) {
+					savedRows[r] = false;
 
-					file << " d=\"M " << rVert1.x << ' ' << rVert1.y << " L " << rVert2.x << ' ' << rVert2.y << "\"/>\n";
+					continue;
 				}
 
-				file << "</g>\n";
-			}
+				// Tiles are mostly small, so each flushes in smaller writes than a whole file's
+				CSvgWriter writer(&file, 1 << 16);
+
+				if (uPrintFlags & Compact) {
+					writer.SetCompact(uSignificantDigits, std::ceil(fTileSize));
+				}
 
-			if (uPrintFlags & Verts) {
-				file << "<g stroke=\"none\">\n";
+				writer << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"" << fTileMinX << ' ' << fTileMinY << ' ' << fTileSize << ' ' <<
+					fTileSize << "\">" << writer.GetOptionalNewLine();
 
-				for (u32 fv = 0; fv < rFace.size(); ++fv) {
-					const CVector3& rVert = m_Vertices[rFace[fv]];
+				for (u32 fi = 0; fi < rFaceIndices.size(); ++fi) {
+					if (!keptFaces[fi]) {
+						continue;
+					}
+
+					const u32 uFaceIndex = rFaceIndices[fi];
+					const u64 uSideOffset = m_Faces.GetIndexOffset(uFaceIndex);
 
-					file << "<circle fill=\"#" << std::hex << std::setw(6) << ComputeRGB(uPrintFlags, Verts, rFace[fv]) << std::dec << "\" cx=\"" << rVert.x << "\" cy=\"" << rVert.y << "\" r=\"0.0625\"/>\n";
+					WriteDepthOrderedFace(writer, uPrintFlags, uFaceIndex, faceAttributes[uFaceIndex].m_uAlpha, sideEdges.data() + uSideOffset, sideFlags.data() + uSideOffset);
 				}
 
-				file << "</g>\n";
+				writer.EndRun();
+				writer << "</svg>" << writer.GetOptionalNewLine();
+
+				if (!CloseSvgFile(writer, file)) {
+					savedRows[r] = false;
+				}
 			}
 		}
-	} else {
-		if (uPrintFlags & Faces) {
-			file << "<g stroke=\"none\">\n";
+	}, 1);
 
-			for (u32 i = 0; i < m_Faces.size(); ++i) {
-				const std::vector<u32>& rFace = m_Faces[i];
-				const CVector3 faceNormal = GetFaceNormal(i);
+	return std::all_of(savedRows.begin(), savedRows.end(), [](u8 uSavedRow) { return uSavedRow; });
+}
 
-				file << "<path fill=\"#" << std::hex << std::setw(8) <<
-					(((uPrintFlags & Color ? ComputeRGB(uPrintFlags, Faces, i) : 0x00FF00) << 8) + 
-					ComputeAlpha(sqrt(
-						(faceNormal.x * faceNormal.x + faceNormal.y * faceNormal.y) /
-						faceNormal.GetMagnitudeSquared()))) << std::dec <<
-					"\"";
+// A fileName ending in .svgz is gzip-compressed as it's written, at zlib's sCompressionLevel
+bool CPolyhedron::SaveToSvg(std::string fileName, u32 uPrintFlags, u32 uSignificantDigits, s32 sCompressionLevel) const {
+	if (!(uPrintFlags & (Verts | Edges | Faces))) {
+		return false;
+	}
 
-				if (rFace.size()) {
-					const CVector3& rVert0 = m_Vertices[rFace[0]];
+	CExtrema extrema;
 
-					file << " d=\"M " << rVert0.x << ' ' << rVert0.y;
+	for (u64 i = 0; i < m_Vertices.size(); ++i) {
+		extrema.ReEvaluate(m_Vertices[i]);
+	}
 
-					for (u32 fv = 1; fv < rFace.size(); ++fv) {
-						const CVector3& rVert = m_Vertices[rFace[fv]];
-						file << " L " << rVert.x << ' ' << rVert.y;
+	const std::unique_ptr<std::ostream> pFile = OpenSvgFile(fileName, sCompressionLevel);
+
+	if (!pFile) {
+		return false;
+	}
+
+	CSvgWriter writer(pFile.get());
+	CMappedVector<SFaceAttributes> faceAttributes;
+
+	if (uPrintFlags & Faces) {
+		PopulateFaceAttributes(faceAttributes);
+	}
+
+	WriteSvgHeader(writer, extrema, uPrintFlags, uSignificantDigits);
+
+	if (uPrintFlags & Depth && uPrintFlags & Faces) {
+		CMappedVector<u32> faceIndices(m_Faces.size(), 0);
+		CMappedVector<u8> visibleFaces;
+		CMappedVector<u32> sideEdges;
+		CMappedVector<u8> sideFlags;
+
+		SortFaceIndicesByHeight(faceAttributes, faceIndices);
+
+		if (uPrintFlags & CullHiddenFaces) {
+			PopulateVisibleFaces(fileName, faceAttributes, faceIndices, visibleFaces);
+		}
+
+		m_Faces.PopulateSideEdges(m_Edges, sideEdges);
+		PopulateSideFlags(faceIndices, visibleFaces, sideEdges, sideFlags);
+
+		// Each batch of sorted faces is split into contiguous chunks, formatted on their own threads, and then written out
+		// in chunk order, so painter's order holds while the text in memory at once stays bounded
+		const u32 uChunkCount = computeChunkCount(faceIndices.size(), g_kuSvgChunkFaceCount);
+		const u64 uBatchFaceCount = static_cast<u64>(uChunkCount) * g_kuSvgChunkFaceCount;
+		std::vector<std::unique_ptr<CSvgWriter>> chunkWriters;
+
+		for (u32 c = 0; c < uChunkCount; ++c) {
+			chunkWriters.push_back(std::make_unique<CSvgWriter>(nullptr));
+			chunkWriters.back()->CopyFormat(writer);
+		}
+
+		for (u64 uBatchBegin = 0; uBatchBegin < faceIndices.size(); uBatchBegin += uBatchFaceCount) {
+			const u64 uBatchSize = std::min<u64>(uBatchFaceCount, faceIndices.size() - uBatchBegin);
+
+			parallelForChunks(uChunkCount, [&](u32 uChunk) {
+				CSvgWriter& rChunkWriter = *chunkWriters[uChunk];
+				const u64 uEnd = uBatchBegin + computeChunkBegin(uBatchSize, uChunkCount, uChunk + 1);
+
+				rChunkWriter.Clear();
+
+				for (u64 fi = uBatchBegin + computeChunkBegin(uBatchSize, uChunkCount, uChunk); fi < uEnd; ++fi) {
+					const u32 uFaceIndex = faceIndices[fi];
+
+					if (uPrintFlags & CullHiddenFaces && !visibleFaces[uFaceIndex]) {
+						#if DBG_PH_STS
+							std::cout << "Culling face " << uFaceIndex << std::endl;
+						#endif // DBG_PH_STS
+
+						continue;
 					}
 
-					file << " Z\"";
+					const u64 uSideOffset = m_Faces.GetIndexOffset(uFaceIndex);
+
+					WriteDepthOrderedFace(rChunkWriter, uPrintFlags, uFaceIndex, faceAttributes[uFaceIndex].m_uAlpha, sideEdges.data() + uSideOffset, sideFlags.data() + uSideOffset);
 				}
 
-				file << "/>\n";
-			}
+				// Runs end with their chunk, which costs a few elements per chunk at most
+				rChunkWriter.EndRun();
+			});
 
-			file << "</g>\n";
+			for (const std::unique_ptr<CSvgWriter>& rChunkWriter : chunkWriters) {
+				writer.Write(rChunkWriter->GetData(), rChunkWriter->GetSize());
+			}
 		}
+	} else {
+		for (u32 uIndexType : { Faces, Edges, Verts }) {
+			if (uPrintFlags & uIndexType) {
+				WriteGroupedElements(writer, uPrintFlags, uIndexType, faceAttributes);
+			}
+		}
+	}
 
-		if (uPrintFlags & Edges) {
-			if (uPrintFlags & Color) {
-				for (u32 i = 0; i < m_Edges.size(); ++i) {
-					const std::pair<u32, u32>& rEdge = m_Edges[i];
-					const CVector3& rStartVert = m_Vertices[rEdge.first];
-					const CVector3& rEndVert = m_Vertices[rEdge.second];
+	writer << "</svg>" << writer.GetOptionalNewLine();
 
-					file << "<path stroke-width=\"0.03125\" fill=\"none\" stroke-linecap=\"round\" stroke=\"#" << std::hex << std::setw(8) <<
-						ComputeRGB(uPrintFlags, Edges, i) << std::dec <<
-						"\" d=\"M " << rStartVert.x << ' ' << rStartVert.y << " L " << rEndVert.x << ' ' << rEndVert.y << "\"/>\n";
-				}
-			} else {
-				file << "<path stroke-width=\"0.03125\" fill=\"none\" stroke-linecap=\"round\" stroke=\"black\" d=\"\n";
+	return CloseSvgFile(writer, *pFile);
+}
 
-				for (u32 i = 0; i < m_Edges.size(); ++i) {
-					const std::pair<u32, u32>& rEdge = m_Edges[i];
-					const CVector3& rStartVert = m_Vertices[rEdge.first];
-					const CVector3& rEndVert = m_Vertices[rEdge.second];
+// The view is a rotation of z with the x (3-fold) or y (5-fold) axis
+void CPolyhedron::ComputeViewRotation(EPerspective ePerspective, u32& ruRotatedAxis, f64& rdCos, f64& rdSin) {
+	ruRotatedAxis = ePerspective == FiveFoldSymmetry ? 1 : 0;
+	rdCos =
+		ePerspective == ThreeFoldSymmetry ?	g_kd3FoldSymmetryCos :
+		ePerspective == FiveFoldSymmetry ?	g_kd5FoldSymmetryCos :
+											1.0;
+	rdSin =
+		ePerspective == ThreeFoldSymmetry ?	 g_kd3FoldSymmetrySin :
+		ePerspective == FiveFoldSymmetry ?	-g_kd5FoldSymmetrySin :
+											 0.0;
+}
 
-					file << "M " << rStartVert.x << ' ' << rStartVert.y << " L " << rEndVert.x << ' ' << rEndVert.y << '\n';
-				}
+// Writes the same file as CPolyhedron(rPhiFractal.Materialize(), ePerspective).SaveToSvg(fileName, uPrintFlags,
+// uSignificantDigits), but depth-ordered output is streamed from a CFaceStream, so the fractal's faces are never all
+// held in memory at once. Given rCacheName, other outputs reuse the geometry saved in rCacheName.phi and
+// rCacheName_<ePerspective>.poly by earlier calls, or save it there for later ones. Where Instanced applies, the file is
+// written by SaveInstancedFractalToSvg() instead, which renders the same but isn't the same text
+bool CPolyhedron::SaveFractalToSvg(const CPhiFractal& rPhiFractal, EPerspective ePerspective, std::string fileName, u32 uPrintFlags, const std::string& rCacheName, u32 uSignificantDigits, s32 sCompressionLevel) {
+	// Colors follow each copy's levels, and culling each copy's surroundings, so either makes copies draw differently. A
+	// depth-ordered file interleaves copies' faces wherever copies overlap, which a <use> of a whole copy can't
+	if (uPrintFlags & Instanced && !(uPrintFlags & (Color | CullHiddenFaces)) && !(uPrintFlags & Depth && uPrintFlags & Faces)) {
+		return SaveInstancedFractalToSvg(rPhiFractal, ePerspective, fileName, uPrintFlags, uSignificantDigits, sCompressionLevel);
+	}
+
+	uPrintFlags &= ~Instanced;
 
-				file << "\"/>\n";
+	if (!(uPrintFlags & Depth && uPrintFlags & Faces)) {
+		// The other outputs are grouped by element type rather than depth, so aren't worth streaming
+		if (rCacheName.empty()) {
+			return CPolyhedron(rPhiFractal.Materialize(), ePerspective).SaveToSvg(fileName, uPrintFlags, uSignificantDigits, sCompressionLevel);
+		}
+
+		const u64 uPhiKey = rPhiFractal.ComputeKey();
+		const u64 uKey = hashWords64(&ePerspective, sizeof(ePerspective), uPhiKey);
+		const std::string phiCacheFileName = rCacheName + ".phi";
+		const std::string cacheFileName = rCacheName + '_' + std::to_string(ePerspective) + ".poly";
+		CPolyhedron polyhedron;
+
+		if (!polyhedron.LoadGeometry(cacheFileName, uKey)) {
+			CPhiPolyhedron phiPolyhedron;
+
+			if (!phiPolyhedron.LoadGeometry(phiCacheFileName, uPhiKey)) {
+				phiPolyhedron = rPhiFractal.Materialize();
+				phiPolyhedron.SaveGeometry(phiCacheFileName, uPhiKey);
 			}
+
+			polyhedron = CPolyhedron(phiPolyhedron, ePerspective);
+			polyhedron.SaveGeometry(cacheFileName, uKey);
 		}
 
-		if (uPrintFlags & Verts) {
-			if (uPrintFlags & Color) {
-				for (u32 i = 0; i < m_Vertices.size(); ++i) {
-					const CVector3& rVert = m_Vertices[i];
+		return polyhedron.SaveToSvg(fileName, uPrintFlags, uSignificantDigits, sCompressionLevel);
+	}
 
-					file << "<circle stroke=\"none\" fill=\"#" << std::hex << std::setw(8) <<
-						ComputeRGB(uPrintFlags, Verts, i) << std::dec <<
-						"\" cx=\"" << rVert.x << "\" cy=\"" << rVert.y << "\" r=\"0.0625\"/>\n";
-				}
-			} else  {
-				file << "<g stroke=\"none\" fill=\"green\">\n";
+	const std::unique_ptr<std::ostream> pFile = OpenSvgFile(fileName, sCompressionLevel);
+
+	if (!pFile) {
+		return false;
+	}
 
-				for (u32 i = 0; i < m_Vertices.size(); ++i) {
-					const CVector3& rVert = m_Vertices[i];
+	const bool bShouldCull = uPrintFlags & CullHiddenFaces;
+	CFaceStream faceStream(rPhiFractal, ePerspective, bShouldCull);
+	const u32* pSideEdges = faceStream.GetSideEdges().data();
+	CFaceStream::SFace face;
+	std::vector<u8> sideFlags;
 
-					file << "<circle cx=\"" << rVert.x << "\" cy=\"" << rVert.y << "\" r=\"0.0625\"/>\n";
-				}
+	CSvgWriter writer(pFile.get());
+
+	WriteSvgHeader(writer, faceStream.ComputeExtrema(), uPrintFlags, uSignificantDigits);
+
+	if (bShouldCull) {
+		// Visibility is decided front to back, but faces are painted back to front, so the visible ones are buffered, end
+		// to end in storage that's mapped once it outgrows the heap
+		CSvgWriter visibleFaceSvgs(nullptr);
+		CMappedVector<u64> visibleFaceSvgEnds;
+		CPolygon polyMask;
+
+		visibleFaceSvgs.CopyFormat(writer);
+		CVector2::ResetCache();
+
+		while (faceStream.Next(face)) {
+			// A back face is always covered by the front faces of its own convex cell, so an empty polygon stands in for it
+			CPolygon polyForFace(IsBackFacing(*face.m_pAttributes) ? CPolygon() : face.m_pCopy->GeneratePolygonForFace(face.m_uFace));
+
+			polyMask |= polyForFace;
 
-				file << "</g>\n";
+			if (polyMask.WereAnyNewLoopsAdded()) {
+				// The faces are written out in reverse, so each one's text has to stand alone
+				faceStream.ClaimSides(face, sideFlags);
+				face.m_pCopy->WriteDepthOrderedFace(visibleFaceSvgs, uPrintFlags, face.m_uFace, face.m_pAttributes->m_uAlpha, pSideEdges + face.m_pCopy->m_Faces.GetIndexOffset(face.m_uFace), sideFlags.data());
+				visibleFaceSvgs.EndRun();
+				visibleFaceSvgEnds.push_back(visibleFaceSvgs.GetSize());
 			}
 		}
+
+		for (u64 uFace = visibleFaceSvgEnds.size(); uFace-- > 0;) {
+			const u64 uBegin = uFace ? visibleFaceSvgEnds[uFace - 1] : 0;
+
+			writer.Write(visibleFaceSvgs.GetData() + uBegin, visibleFaceSvgEnds[uFace] - uBegin);
+		}
+	} else {
+		while (faceStream.Next(face)) {
+			faceStream.ClaimSides(face, sideFlags);
+			face.m_pCopy->WriteDepthOrderedFace(writer, uPrintFlags, face.m_uFace, face.m_pAttributes->m_uAlpha, pSideEdges + face.m_pCopy->m_Faces.GetIndexOffset(face.m_uFace), sideFlags.data());
+		}
+
+		writer.EndRun();
 	}
 
-	file << "</svg>\n";
+	writer << "</svg>" << writer.GetOptionalNewLine();
 
-	return true;
+	return CloseSvgFile(writer, *pFile);
 }
 
-bool CPolyhedron::CompareFaceIndices(u32 uFaceIndexA, u32 uFaceIndexB) const {
-	if (std::max(uFaceIndexA, uFaceIndexB) >= m_Faces.size()) {
-		std::cout << "CPolyhedron::SortFaceIndicesByHeight(): invalid index: too large\n";
-
+// Defines the base once, and each level after it as <use>s of the level before, translated to each of its copies, so
+// the file grows with the level count rather than the copy count. Only grouped output is instanced, matching the explicit
+// file's order
+bool CPolyhedron::SaveInstancedFractalToSvg(const CPhiFractal& rPhiFractal, EPerspective ePerspective, std::string fileName, u32 uPrintFlags, u32 uSignificantDigits, s32 sCompressionLevel) {
+	if (!(uPrintFlags & (Verts | Edges | Faces))) {
 		return false;
 	}
 
-	const std::vector<u32>& rFaceA = m_Faces[uFaceIndexA];
-	const std::vector<u32>& rFaceB = m_Faces[uFaceIndexB];
-	f32 dFaceZSumA = 0.0, dFaceZSumB = 0.0;
+	const std::unique_ptr<std::ostream> pFile = OpenSvgFile(fileName, sCompressionLevel);
 
-	for (u32 va = 0; va < rFaceA.size(); ++va) {
-		dFaceZSumA += m_Vertices[rFaceA[va]].z;
+	if (!pFile) {
+		return false;
 	}
 
-	for (u32 vb = 0; vb < rFaceB.size(); ++vb) {
-		dFaceZSumB += m_Vertices[rFaceB[vb]].z;
-	}
+	const u32 uLevelCount = rPhiFractal.GetLevelCount();
+	const CPolyhedron basePolyhedron(rPhiFractal.GetBase(), ePerspective);
+	std::vector<CPolyhedron> levelTranslations(uLevelCount);	// Projected
+	CMappedVector<SFaceAttributes> faceAttributes;
 
-	return (dFaceZSumA / std::max(rFaceA.size(), 1ul)) < (dFaceZSumB / std::max(rFaceB.size(), 1ul));
-}
+	for (u32 l = 0; l < uLevelCount; ++l) {
+		const std::vector<CPhiVector3>& rTranslations = rPhiFractal.GetLevelTranslations(l);
+		CPhiPolyhedron translations;
 
-u32 CPolyhedron::ComputeRGB(u32 uPrintFlags, u32 uIndexType, u32 uIndex) const {
-	const u32 uBlack = 0x000000;
+		translations.m_Vertices.assign(rTranslations.begin(), rTranslations.end());
+		levelTranslations[l].ProjectVertices(translations, ePerspective);
+	}
 
-	if (!(uPrintFlags & Color && (uPrintFlags & Icosahedron || uPrintFlags & Icosidodecahedron)) || !(uPrintFlags & uIndexType)) {
-		return uBlack;
+	if (uPrintFlags & Faces) {
+		basePolyhedron.PopulateFaceAttributes(faceAttributes);
 	}
 
-	const u32 uBaseVerts = uPrintFlags & Icosahedron ? 12 : 30;
-	u32 uBaseTypeCount;
-	u32 uIterations = 1;
-	u32 uIndexMatches = 1;
-	u32 uOriginalIndex;
+	CSvgWriter writer(pFile.get());
 
-	switch (uIndexType) {
-		case Verts:
+	// One group per element type, as in the explicit file
+	std::vector<std::pair<c8, u32>> groups;
 
-			uBaseTypeCount = uBaseVerts;
-			uIterations = ComputeU32Log(m_Vertices.size(), uBaseVerts);
-			uOriginalIndex = uIndex % uBaseTypeCount;
-			uIndex /= uBaseTypeCount;
+	for (const std::pair<c8, u32>& rGroup : { std::pair<c8, u32>('f', Faces), std::pair<c8, u32>('e', Edges), std::pair<c8, u32>('v', Verts) }) {
+		if (uPrintFlags & rGroup.second) {
+			groups.push_back(rGroup);
+		}
+	}
 
-			for (u32 i = 1; i < uIterations; ++i) {
-				if (uIndex % uBaseVerts != uOriginalIndex) {
-					return ComputeRGB(uIterations - uIndexMatches);
-				}
+	const auto writeLevel = [&](u32 uLevel, c8 cGroupId, u32 uIndexType) {
+		if (uLevel) {
+			const CMappedVector<CVector3>& rProjectedTranslations = levelTranslations[uLevel - 1].m_Vertices;
 
-				uIndex /= uBaseVerts;
-				++uIndexMatches;
+			for (u32 uTranslation = 0; uTranslation < rProjectedTranslations.size(); ++uTranslation) {
+				writer << "<use xlink:href=\"#" << cGroupId << static_cast<s32>(uLevel - 1) << "\" x=\"" <<
+					rProjectedTranslations[uTranslation].x << "\" y=\"" << rProjectedTranslations[uTranslation].y << "\"/>" <<
+					writer.GetOptionalNewLine();
 			}
+		} else {
+			basePolyhedron.WriteGroupedElements(writer, uPrintFlags, uIndexType, faceAttributes);
+		}
+	};
 
-			break;
-		case Edges: {
-			uBaseTypeCount = uPrintFlags & Icosahedron ? 30 : 60;
-			uIterations = ComputeU32Log(m_Edges.size() / uBaseTypeCount, uBaseVerts) + 1;
-			uOriginalIndex = uIndex % uBaseTypeCount;
-			uIndex /= uBaseTypeCount;
+	WriteSvgHeader(writer, CFaceStream(rPhiFractal, ePerspective).ComputeExtrema(), uPrintFlags, uSignificantDigits);
 
-			const std::pair<u32, u32>& rEdge = m_Edges[uOriginalIndex];
+	if (uLevelCount) {
+		writer << "<defs>" << writer.GetOptionalNewLine();
 
-			for (u32 i = 1; i < uIterations; ++i) {
-				const u32 uCurrIndex = uIndex % uBaseVerts;
+		for (const std::pair<c8, u32>& rGroup : groups) {
+			for (u32 l = 0; l < uLevelCount; ++l) {
+				writer << "<g id=\"" << rGroup.first << static_cast<s32>(l) << "\">" << writer.GetOptionalNewLine();
+				writeLevel(l, rGroup.first, rGroup.second);
+				writer << "</g>" << writer.GetOptionalNewLine();
+			}
+		}
 
-				if (uCurrIndex != rEdge.first && uCurrIndex != rEdge.second) {
-					return ComputeRGB(uIterations - uIndexMatches);
-				}
+		writer << "</defs>" << writer.GetOptionalNewLine();
+	}
 
-				uIndex /= uBaseVerts;
-				++uIndexMatches;
-			}
+	for (const std::pair<c8, u32>& rGroup : groups) {
+		writeLevel(uLevelCount, rGroup.first, rGroup.second);
+	}
 
-			break;
-		}
-		
-		case Faces: {
-			uBaseTypeCount = uPrintFlags & Icosahedron ? 20 : 32;
-			uIterations = ComputeU32Log(m_Edges.size() / uBaseTypeCount, uBaseVerts) + 1;
-			uOriginalIndex = uIndex % uBaseTypeCount;
-			uIndex /= uBaseTypeCount;
+	writer << "</svg>" << writer.GetOptionalNewLine();
 
-			const std::vector<u32>& rFace = m_Faces[uOriginalIndex];
+	return CloseSvgFile(writer, *pFile);
+}
 
-			for (u32 i = 1; i < uIterations; ++i) {
-				const u32 uCurrIndex = uIndex % uBaseVerts;
-				bool bMatchWasFound = false;
+// Elements without tracked levels are colored as the outline is
+u32 CPolyhedron::ComputeRGB(u32 uPrintFlags, u32 uIndexType, u64 uIndex) const {
+	const u32 uBlack = 0x000000;
 
-				for (u32 fv = 0; fv < rFace.size(); ++fv) {
-					bMatchWasFound |= uCurrIndex == rFace[fv];
-				}
+	if (!(uPrintFlags & Color && (uPrintFlags & Icosahedron || uPrintFlags & Icosidodecahedron)) || !(uPrintFlags & uIndexType)) {
+		return uBlack;
+	}
 
-				if (!bMatchWasFound) {
-					return ComputeRGB(uIterations - uIndexMatches);
-				}
+	const CMappedVector<u8>* pLevels;
 
-				uIndex /= uBaseVerts;
-				++uIndexMatches;
-			}
+	switch (uIndexType) {
+		case Verts:
+			pLevels = &m_VertexLevels;
 
 			break;
-		}
+		case Edges:
+			pLevels = &m_EdgeLevels;
 
-		default:
-			return uBlack;
+			break;
+		case Faces:
+			pLevels = &m_FaceLevels;
 
 			break;
+		default:
+			return uBlack;
 	}
 
-	return ComputeRGB(uIterations - uIndexMatches);
+	return ComputeRGB(uIndex < pLevels->size() ? (*pLevels)[uIndex] : 0);
 }
 
-u32 CPolyhedron::ComputeRGBA(u32 uPrintFlags, u32 uFaceIndex) const {
-	const CVector3 faceNormal = GetFaceNormal(uFaceIndex);
-	u32 uRGBA = (ComputeRGB(uPrintFlags, Faces, uFaceIndex) << 8) + 
-		ComputeAlpha(sqrt((faceNormal.x * faceNormal.x + faceNormal.y * faceNormal.y) / faceNormal.GetMagnitudeSquared()));
+u32 CPolyhedron::ComputeRGBA(u32 uPrintFlags, u32 uFaceIndex, u32 uAlpha) const {
+	u32 uRGBA = (ComputeRGB(uPrintFlags, Faces, uFaceIndex) << 8) + uAlpha;
 
 	const float fOpacityBonus = (255 - (uRGBA & 0xFF)) / 255.0f;
 	u8* pAlphaByte = static_cast<u8*>(static_cast<void*>(&uRGBA));
@@ -438,10 +778,44 @@ u32 CPolyhedron::ComputeRGBA(u32 uPrintFlags, u32 uFaceIndex) const {
 	return uRGBA >> 8;
 }
 
+f32 CPolyhedron::ComputeFaceDepth(u32 uFaceIndex) const {
+	const std::span<const u32> face = m_Faces[uFaceIndex];
+	f32 fFaceZSum = 0.0f;
+
+	for (u32 fv = 0; fv < face.size(); ++fv) {
+		fFaceZSum += m_Vertices[face[fv]].z;
+	}
+
+	return fFaceZSum / std::max(face.size(), 1ul);
+}
+
+// Bounds the error of GetFaceNormal(uFaceIndex).z that stems from the vertex errors and the f32 arithmetic
+f32 CPolyhedron::ComputeNormalZErrorBound(u32 uFaceIndex) const {
+	if (m_VertexErrors.size() != m_Vertices.size()) {
+		return g_kfEpsilon;
+	}
+
+	const std::span<const u32> face = m_Faces[uFaceIndex];
+	const CVector3& rVert0 = m_Vertices[face[0]];
+	const CVector3 edge1 = m_Vertices[face[1]] - rVert0;
+	const CVector3 edge2 = m_Vertices[face[2]] - rVert0;
+	const f32 fEdge1Extent = std::abs(edge1.x) + std::abs(edge1.y);
+	const f32 fEdge2Extent = std::abs(edge2.x) + std::abs(edge2.y);
+	const f32 fEdge1Error = m_VertexErrors[face[0]] + m_VertexErrors[face[1]] + 0x1p-24f * fEdge1Extent;
+	const f32 fEdge2Error = m_VertexErrors[face[0]] + m_VertexErrors[face[2]] + 0x1p-24f * fEdge2Extent;
+
+	// normal.z = edge1.x * edge2.y - edge1.y * edge2.x, and (a + da) * (b + db) - a * b = a * db + b * da + da * db
+	return (1.0f + 0x1p-20f) * (
+		fEdge1Error * fEdge2Extent +
+		fEdge2Error * fEdge1Extent +
+		2.0f * fEdge1Error * fEdge2Error +
+		0x1p-22f * (std::abs(edge1.x * edge2.y) + std::abs(edge1.y * edge2.x)));
+}
+
 CVector3 CPolyhedron::GetFaceNormal(u32 uFace, bool bShouldNormalize) const {
-	const std::vector<u32>& rFace = m_Faces[uFace];
+	const std::span<const u32> face = m_Faces[uFace];
 
-	return ComputeNormal(m_Vertices[rFace[0]], m_Vertices[rFace[1]], m_Vertices[rFace[2]], bShouldNormalize);
+	return ComputeNormal(m_Vertices[face[0]], m_Vertices[face[1]], m_Vertices[face[2]], bShouldNormalize);
 }
 
 CPolygon CPolyhedron::GeneratePolygonForFace(u32 uFaceIndex) const {
@@ -454,15 +828,66 @@ CPolygon CPolyhedron::GeneratePolygonForFace(u32 uFaceIndex) const {
 	return polyVertices;
 }
 
-void CPolyhedron::PopulateInverseEdges(std::unordered_map<u64, u32>& rInverseEdges) const {
-	for (u32 e = 0; e < m_Edges.size(); ++e) {
-		const std::pair<u32, u32>& rEdge = m_Edges[e];
+void CPolyhedron::PopulateFaceAttributes(CMappedVector<SFaceAttributes>& rFaceAttributes) const {
+	rFaceAttributes.resize(m_Faces.size());
+
+	parallelFor(m_Faces.size(), [this, &rFaceAttributes](u64 uBegin, u64 uEnd) {
+		for (u32 f = uBegin; f < uEnd; ++f) {
+			SFaceAttributes& rAttributes = rFaceAttributes[f];
+			const CVector3 normal = GetFaceNormal(f);
+			const f32 fPlanarMagnitudeSquared = normal.x * normal.x + normal.y * normal.y;
+
+			rAttributes.m_vNormal = normal;
+			rAttributes.m_Extrema = CExtrema();
+			rAttributes.m_fDepth = ComputeFaceDepth(f);
+			rAttributes.m_fNormalZErrorBound = ComputeNormalZErrorBound(f);
+			rAttributes.m_uAlpha = ComputeAlpha(sqrt(fPlanarMagnitudeSquared / (fPlanarMagnitudeSquared + normal.z * normal.z)));
+
+			for (u32 uVertIndex : m_Faces[f]) {
+				rAttributes.m_Extrema.ReEvaluate(m_Vertices[uVertIndex]);
+			}
+		}
+	});
+}
+
+// Flags the edge and vertex of each side of the last face in rFaceIndices to touch them, skipping the faces that
+// rVisibleFaces culls unless it's empty, so painting in that order writes each once, and on top of every face around it
+void CPolyhedron::PopulateSideFlags(const CMappedVector<u32>& rFaceIndices, const CMappedVector<u8>& rVisibleFaces, const CMappedVector<u32>& rSideEdges, CMappedVector<u8>& rSideFlags) const {
+	CMappedVector<u64> lastEdgeSides(m_Edges.size(), u64_MAX);
+	CMappedVector<u64> lastVertSides(m_Vertices.size(), u64_MAX);
+
+	for (u32 uFaceIndex : rFaceIndices) {
+		if (rVisibleFaces.size() && !rVisibleFaces[uFaceIndex]) {
+			continue;
+		}
+
+		const std::span<const u32> face = m_Faces[uFaceIndex];
+		const u64 uOffset = m_Faces.GetIndexOffset(uFaceIndex);
+
+		for (u32 fv = 0; fv < face.size(); ++fv) {
+			lastEdgeSides[rSideEdges[uOffset + fv]] = uOffset + fv;
+			lastVertSides[face[fv]] = uOffset + fv;
+		}
+	}
+
+	rSideFlags.assign(m_Faces.GetIndexCount(), 0);
 
-		rInverseEdges.emplace(static_cast<u64>(rEdge.first) + (static_cast<u64>(rEdge.second) << 32), e);
+	for (u64 uSide : lastEdgeSides) {
+		if (uSide != u64_MAX) {
+			rSideFlags[uSide] |= SideEdge;
+		}
+	}
+
+	for (u64 uSide : lastVertSides) {
+		if (uSide != u64_MAX) {
+			rSideFlags[uSide] |= SideVert;
+		}
 	}
 }
 
-void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const std::vector<u32>& rFaceIndices, std::unordered_set<u32>& rVisibleFaces) const {
+void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const CMappedVector<SFaceAttributes>& rFaceAttributes, const CMappedVector<u32>& rFaceIndices, CMappedVector<u8>& rVisibleFaces) const {
+	rVisibleFaces.assign(m_Faces.size(), false);
+
 	if (!rFaceIndices.size()) {
 		return;
 	}
@@ -485,6 +910,7 @@ void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const std::
 			const u32 uFaceCount = m_Faces.size();
 			u32 uRemainingFaces = uFaceCount;
 			const u32 uMaxDigits = static_cast<u32>(log10(uFaceCount)) + 1;
+			u32 uVisible = 0;
 			std::vector<u64> aRecentDurations[2] = { std::vector<u64>(16), std::vector<u64>(16) };
 			u32 auRecentDurationIndices[2] = { 0, 0 };
 			u64 auRecentDurationSums[2] = { 0, 0 };
@@ -495,7 +921,7 @@ void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const std::
 		#endif // !DBG_PH_PVF_SVG
 	#endif // DBG_PH_PVF
 
-	for (std::vector<u32>::const_reverse_iterator faceIndicesIter = rFaceIndices.rbegin(); faceIndicesIter != rFaceIndices.rend(); ++faceIndicesIter) {
+	for (CMappedVector<u32>::const_reverse_iterator faceIndicesIter = rFaceIndices.rbegin(); faceIndicesIter != rFaceIndices.rend(); ++faceIndicesIter) {
 		#if DBG_PH_PVF_SVG
 			std::stringstream svgName;
 
@@ -503,12 +929,13 @@ void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const std::
 			g_log << svgName.str() << ":\n" << indent;
 		#endif // DBG_PH_PVF_SVG
 		
-		CPolygon polyForFace(GeneratePolygonForFace(*faceIndicesIter));
+		// A back face is always covered by the front faces of its own convex cell, so an empty polygon stands in for it
+		CPolygon polyForFace(IsBackFacing(rFaceAttributes[*faceIndicesIter]) ? CPolygon() : GeneratePolygonForFace(*faceIndicesIter));
 
 		polyMask |= polyForFace;
 
 		if (polyMask.WereAnyNewLoopsAdded()) {
-			rVisibleFaces.insert(*faceIndicesIter);
+			rVisibleFaces[*faceIndicesIter] = true;
 		}
 
 		#if DBG_PH_PVF
@@ -532,7 +959,7 @@ void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const std::
 			#else // DBG_PH_PVF_SVG
 				++sm_uMaskLevel;
 				--uRemainingFaces;
-				const u32 uVisible = rVisibleFaces.size();
+				uVisible += polyMask.WereAnyNewLoopsAdded();
 				const f32 fCompletionPercent = sm_uMaskLevel * 100.0f / uFaceCount;
 				const f32 fVisiblePortion = static_cast<f32>(uVisible) / sm_uMaskLevel;
 				const time_point currTime = now();
@@ -566,19 +993,268 @@ void CPolyhedron::PopulateVisibleFaces(const std::string& rFileName, const std::
 	#endif // !DBG_PH_PVF_SVG
 }
 
-void CPolyhedron::SortFaceIndicesByHeight(std::vector<u32>& rFaceIndices) const {
-	if (rFaceIndices.size() != m_Faces.size()) {
-		rFaceIndices.resize(m_Faces.size());
+void CPolyhedron::SortFaceIndicesByHeight(const CMappedVector<SFaceAttributes>& rFaceAttributes, CMappedVector<u32>& rFaceIndices) const {
+	const u64 uFaceCount = m_Faces.size();
+	CMappedVector<u32> faceKeys(uFaceCount);
+
+	rFaceIndices.resize(uFaceCount);
+
+	// Gather every face's depth into a contiguous key array, so the sort itself never touches the vertices
+	parallelFor(uFaceCount, [&rFaceAttributes, &faceKeys, &rFaceIndices](u64 uBegin, u64 uEnd) {
+		for (u64 f = uBegin; f < uEnd; ++f) {
+			faceKeys[f] = computeSortableKey(rFaceAttributes[f].m_fDepth);
+			rFaceIndices[f] = f;
+		}
+	});
+
+	radixSort(faceKeys, rFaceIndices);
+}
+
+// Writes a face, and then on top of it the edges and vertices of its sides that pSideFlags flags, pSideEdges and
+// pSideFlags pointing to the face's first side
+void CPolyhedron::WriteDepthOrderedFace(CSvgWriter& rWriter, u32 uPrintFlags, u32 uFaceIndex, u32 uAlpha, const u32* pSideEdges, const u8* pSideFlags) const {
+	const std::span<const u32> face = m_Faces[uFaceIndex];
+
+	if (!face.size()) {
+		return;
+	}
+
+	const u32 uFaceRGB = ComputeRGBA(uPrintFlags, uFaceIndex, uAlpha);
+
+	if (uPrintFlags & Batched) {
+		// Every face is wound the same way, so that nonzero filling unites overlapping faces rather than cancelling them
+		if (!rWriter.ContinueRun(static_cast<u64>(Faces) << 32 | uFaceRGB)) {
+			rWriter << "<path fill=\"#" << svgHex(uFaceRGB, 6) << "\" d=\"";
+		}
+
+		WriteFacePathData(rWriter, uFaceIndex, true);
+	} else {
+		rWriter << "<path fill=\"#" << svgHex(uFaceRGB, 6) << "\" d=\"";
+		WriteFacePathData(rWriter, uFaceIndex);
+		rWriter << "\"/>" << rWriter.GetOptionalNewLine();
+	}
+
+	const auto hasFlaggedSide = [pSideFlags, &face](u8 uSideFlag) {
+		return std::any_of(pSideFlags, pSideFlags + face.size(), [uSideFlag](u8 uSideFlags) { return uSideFlags & uSideFlag; });
+	};
+
+	if (uPrintFlags & Edges && hasFlaggedSide(SideEdge)) {
+		rWriter.EndRun();
+		rWriter << "<g fill=\"none\" stroke-width=\"" << (rWriter.IsCompact() ? ".03125" : "0.03125") << "\" stroke-linecap=\"round\">" <<
+			rWriter.GetOptionalNewLine();
+
+		for (u32 fv = 0; fv < face.size(); ++fv) {
+			if (!(pSideFlags[fv] & SideEdge)) {
+				continue;
+			}
+
+			u32 uVertIndex1 = face[fv];
+			u32 uVertIndex2 = face[(fv + 1) % face.size()];
+
+			if (uVertIndex1 > uVertIndex2) {
+				std::swap(uVertIndex1, uVertIndex2);
+			}
+
+			const u32 uEdgeRGB = ComputeRGB(uPrintFlags, Edges, pSideEdges[fv]);
+			const bool bContinuesRun = uPrintFlags & Batched && rWriter.ContinueRun(static_cast<u64>(Edges) << 32 | uEdgeRGB);
+
+			if (!bContinuesRun) {
+				rWriter << "<path stroke=\"#" << svgHex(uEdgeRGB, 6) << "\" d=\"";
+			}
+
+			WriteLinePathData(rWriter, m_Vertices[uVertIndex1], m_Vertices[uVertIndex2]);
+
+			if (!(uPrintFlags & Batched)) {
+				rWriter << "\"/>" << rWriter.GetOptionalNewLine();
+			}
+		}
+
+		rWriter.EndRun();
+		rWriter << "</g>" << rWriter.GetOptionalNewLine();
+	}
+
+	if (uPrintFlags & Verts && hasFlaggedSide(SideVert)) {
+		const std::string_view radius = rWriter.IsCompact() ? ".0625" : "0.0625";
+
+		rWriter.EndRun();
+		rWriter << "<g stroke=\"none\">" << rWriter.GetOptionalNewLine();
+
+		for (u32 fv = 0; fv < face.size(); ++fv) {
+			if (!(pSideFlags[fv] & SideVert)) {
+				continue;
+			}
+
+			const CVector3& rVert = m_Vertices[face[fv]];
+			const u32 uVertRGB = ComputeRGB(uPrintFlags, Verts, face[fv]);
+
+			if (!(uPrintFlags & Batched)) {
+				rWriter << "<circle fill=\"#" << svgHex(uVertRGB, 6) << "\" cx=\"" << rVert.x << "\" cy=\"" << rVert.y << "\" r=\"" << radius << "\"/>" <<
+					rWriter.GetOptionalNewLine();
+
+				continue;
+			}
+
+			// A path can't hold circles, but it can hold two half-circle arcs drawn from the leftmost point
+			if (!rWriter.ContinueRun(static_cast<u64>(Verts) << 32 | uVertRGB)) {
+				rWriter << "<path fill=\"#" << svgHex(uVertRGB, 6) << "\" d=\"";
+			}
+
+			rWriter << 'M' << rVert.x - 0.0625f << ' ' << rVert.y <<
+				(rWriter.IsCompact() ? "a.0625.0625 0 1 0 .125 0 .0625.0625 0 1 0-.125 0" : " a 0.0625 0.0625 0 1 0 0.125 0 a 0.0625 0.0625 0 1 0 -0.125 0");
+		}
+
+		rWriter.EndRun();
+		rWriter << "</g>" << rWriter.GetOptionalNewLine();
+	}
+}
+
+// Writes every element of one type, grouped rather than depth-ordered
+void CPolyhedron::WriteGroupedElements(CSvgWriter& rWriter, u32 uPrintFlags, u32 uIndexType, const CMappedVector<SFaceAttributes>& rFaceAttributes) const {
+	if (uIndexType == Faces) {
+		rWriter << "<g stroke=\"none\">" << rWriter.GetOptionalNewLine();
+
+		for (u64 i = 0; i < m_Faces.size(); ++i) {
+			rWriter << "<path fill=\"#" <<
+				svgHex(((uPrintFlags & Color ? ComputeRGB(uPrintFlags, Faces, i) : 0x00FF00) << 8) + rFaceAttributes[i].m_uAlpha, 8) <<
+				"\"";
+
+			if (m_Faces[i].size()) {
+				rWriter << " d=\"";
+				WriteFacePathData(rWriter, i);
+				rWriter << "\"";
+			}
+
+			rWriter << "/>" << rWriter.GetOptionalNewLine();
+		}
+
+		rWriter << "</g>" << rWriter.GetOptionalNewLine();
+	} else if (uIndexType == Edges) {
+		const std::string_view strokeWidth = rWriter.IsCompact() ? ".03125" : "0.03125";
+
+		if (uPrintFlags & Color) {
+			for (u64 i = 0; i < m_Edges.size(); ++i) {
+				const std::pair<u32, u32>& rEdge = m_Edges[i];
+				const CVector3& rStartVert = m_Vertices[rEdge.first];
+				const CVector3& rEndVert = m_Vertices[rEdge.second];
+
+				rWriter << "<path stroke-width=\"" << strokeWidth << "\" fill=\"none\" stroke-linecap=\"round\" stroke=\"#" <<
+					svgHex(ComputeRGB(uPrintFlags, Edges, i), 8) <<
+					"\" d=\"";
+				WriteLinePathData(rWriter, rStartVert, rEndVert);
+				rWriter << "\"/>" << rWriter.GetOptionalNewLine();
+			}
+		} else {
+			rWriter << "<path stroke-width=\"" << strokeWidth << "\" fill=\"none\" stroke-linecap=\"round\" stroke=\"black\" d=\"" <<
+				rWriter.GetOptionalNewLine();
+
+			for (u64 i = 0; i < m_Edges.size(); ++i) {
+				const std::pair<u32, u32>& rEdge = m_Edges[i];
+
+				WriteLinePathData(rWriter, m_Vertices[rEdge.first], m_Vertices[rEdge.second]);
+				rWriter << rWriter.GetOptionalNewLine();
+			}
+
+			rWriter << "\"/>" << rWriter.GetOptionalNewLine();
+		}
+	} else if (uIndexType == Verts) {
+		const std::string_view radius = rWriter.IsCompact() ? ".0625" : "0.0625";
+
+		if (uPrintFlags & Color) {
+			for (u64 i = 0; i < m_Vertices.size(); ++i) {
+				const CVector3& rVert = m_Vertices[i];
+
+				rWriter << "<circle stroke=\"none\" fill=\"#" <<
+					svgHex(ComputeRGB(uPrintFlags, Verts, i), 8) <<
+					"\" cx=\"" << rVert.x << "\" cy=\"" << rVert.y << "\" r=\"" << radius << "\"/>" << rWriter.GetOptionalNewLine();
+			}
+		} else  {
+			rWriter << "<g stroke=\"none\" fill=\"green\">" << rWriter.GetOptionalNewLine();
+
+			for (u64 i = 0; i < m_Vertices.size(); ++i) {
+				const CVector3& rVert = m_Vertices[i];
+
+				rWriter << "<circle cx=\"" << rVert.x << "\" cy=\"" << rVert.y << "\" r=\"" << radius << "\"/>" << rWriter.GetOptionalNewLine();
+			}
+
+			rWriter << "</g>" << rWriter.GetOptionalNewLine();
+		}
+	}
+}
+
+// Writes the face as the data of a closed path: absolute, or once compact, relative to its first vertex. Given
+// bShouldWindClockwise, a face whose projection winds counterclockwise in the view's y-down coordinates is reversed
+void CPolyhedron::WriteFacePathData(CSvgWriter& rWriter, u32 uFaceIndex, bool bShouldWindClockwise) const {
+	const std::span<const u32> face = m_Faces[uFaceIndex];
+	const CVector3& rVert0 = m_Vertices[face[0]];
+	f32 fDoubleArea = 0.0f;
+
+	if (bShouldWindClockwise) {
+		for (u32 fv = 0; fv < face.size(); ++fv) {
+			const CVector3& rVert1 = m_Vertices[face[fv]];
+			const CVector3& rVert2 = m_Vertices[face[(fv + 1) % face.size()]];
+
+			fDoubleArea += rVert1.x * rVert2.y - rVert2.x * rVert1.y;
+		}
+	}
+
+	// Vertex fv of the written path
+	const auto getVert = [this, &face, bIsReversed = fDoubleArea < 0.0f](u32 fv) -> const CVector3& {
+		return m_Vertices[face[bIsReversed && fv ? face.size() - fv : fv]];
+	};
+
+	if (!rWriter.IsCompact()) {
+		rWriter << "M " << rVert0.x << ' ' << rVert0.y;
+
+		for (u32 fv = 1; fv < face.size(); ++fv) {
+			const CVector3& rVert = getVert(fv);
+
+			rWriter << " L " << rVert.x << ' ' << rVert.y;
+		}
+
+		rWriter << " Z";
+
+		return;
 	}
 
-	for (u32 i = 0; i < rFaceIndices.size(); ++i) {
-		rFaceIndices[i] = i;
+	// Differencing grid points rather than coordinates keeps rounding errors from accumulating along the path
+	s64 sX = rWriter.Quantize(rVert0.x);
+	s64 sY = rWriter.Quantize(rVert0.y);
+
+	rWriter << 'M';
+	rWriter.WriteQuanta(sX);
+	rWriter.WriteQuanta(sY);
+
+	if (face.size() > 1) {
+		rWriter << 'l';
 	}
 
-	sort(rFaceIndices.begin(), rFaceIndices.end(),
-		[this](u32 uFaceIndexA, u32 uFaceIndexB) -> bool {
-			return CompareFaceIndices(uFaceIndexA, uFaceIndexB);
-		});
+	for (u32 fv = 1; fv < face.size(); ++fv) {
+		const CVector3& rVert = getVert(fv);
+		const s64 sNextX = rWriter.Quantize(rVert.x);
+		const s64 sNextY = rWriter.Quantize(rVert.y);
+
+		rWriter.WriteQuanta(sNextX - sX);
+		rWriter.WriteQuanta(sNextY - sY);
+		sX = sNextX;
+		sY = sNextY;
+	}
+
+	rWriter << 'z';
+}
+
+// Flushes rWriter into rFile, an OpenSvgFile stream or a plain file, and closes it, returning whether all of it was written
+bool CPolyhedron::CloseSvgFile(CSvgWriter& rWriter, std::ostream& rFile) {
+	rWriter.Flush();
+
+	if (CDeflateStream* pDeflateStream = dynamic_cast<CDeflateStream*>(&rFile)) {
+		return pDeflateStream->Close();
+	}
+
+	std::ofstream& rFileStream = static_cast<std::ofstream&>(rFile);
+
+	rFileStream.close();
+
+	return !rFileStream.fail();
 }
 
 u32 CPolyhedron::ComputeAlpha(f32 dT, f32 dMinAlpha, f32 dMaxAlpha) {
@@ -610,17 +1286,72 @@ u32 CPolyhedron::ComputeRGB(u32 uColorLevel) {
 	return 0x000000;
 }
 
-u32 CPolyhedron::ComputeU32Log(u32 x, u32 uBase) {
-	u32 uDivisionCount = 0;
+// The extrema's integer parts, doubled
+void CPolyhedron::ComputeViewBox(const CExtrema& rExtrema, s32& rsMinX, s32& rsMinY, s32& rsWidth, s32& rsHeight) {
+	s32 sMinX = rExtrema.m_vMin.x, sMinY = rExtrema.m_vMin.y, sMaxX = rExtrema.m_vMax.x, sMaxY = rExtrema.m_vMax.y;
 
-	if (!x) {	
-		return 0;
+	rsMinX = sMinX * 2;
+	rsMinY = sMinY * 2;
+	rsWidth = (sMaxX - sMinX) * 2;
+	rsHeight = (sMaxY - sMinY) * 2;
+}
+
+bool CPolyhedron::IsBackFacing(const SFaceAttributes& rFaceAttributes) {
+	// Unless the normal provably faces the viewer, the face is (nearly) edge-on and projects to a sliver
+	return rFaceAttributes.m_vNormal.z <= rFaceAttributes.m_fNormalZErrorBound;
+}
+
+// Opens rFileName to be written, gzip-compressed at sCompressionLevel if it ends in .svgz, or returns null if it can't be
+std::unique_ptr<std::ostream> CPolyhedron::OpenSvgFile(const std::string& rFileName, s32 sCompressionLevel) {
+	std::unique_ptr<std::ostream> pFile;
+
+	if (rFileName.ends_with(".svgz")) {
+		std::unique_ptr<CDeflateStream> pDeflateStream = std::make_unique<CDeflateStream>(rFileName, sCompressionLevel);
+
+		if (pDeflateStream->IsOpen()) {
+			pFile = std::move(pDeflateStream);
+		}
+	} else {
+		std::unique_ptr<std::ofstream> pFileStream = std::make_unique<std::ofstream>(rFileName.c_str(), std::ios_base::trunc);
+
+		if (pFileStream->is_open()) {
+			pFile = std::move(pFileStream);
+		}
+	}
+
+	return pFile;
+}
+
+// Writes the segment as path data: absolute, or once compact, relative to its start
+void CPolyhedron::WriteLinePathData(CSvgWriter& rWriter, const CVector3& rStart, const CVector3& rEnd) {
+	if (!rWriter.IsCompact()) {
+		rWriter << "M " << rStart.x << ' ' << rStart.y << " L " << rEnd.x << ' ' << rEnd.y;
+
+		return;
 	}
 
-	while (x) {
-		x /= uBase;
-		++uDivisionCount;
+	const s64 sStartX = rWriter.Quantize(rStart.x);
+	const s64 sStartY = rWriter.Quantize(rStart.y);
+
+	rWriter << 'M';
+	rWriter.WriteQuanta(sStartX);
+	rWriter.WriteQuanta(sStartY);
+	rWriter << 'l';
+	rWriter.WriteQuanta(rWriter.Quantize(rEnd.x) - sStartX);
+	rWriter.WriteQuanta(rWriter.Quantize(rEnd.y) - sStartY);
+}
+
+// Compact writers round coordinates to uSignificantDigits of the view box's larger side. Instanced files declare the xlink
+// namespace, since SVG 1.1 renderers only follow a <use>'s xlink:href
+void CPolyhedron::WriteSvgHeader(CSvgWriter& rWriter, const CExtrema& rExtrema, u32 uPrintFlags, u32 uSignificantDigits) {
+	s32 sMinX, sMinY, sWidth, sHeight;
+
+	ComputeViewBox(rExtrema, sMinX, sMinY, sWidth, sHeight);
+
+	if (uPrintFlags & Compact) {
+		rWriter.SetCompact(uSignificantDigits, std::max(sWidth, sHeight));
 	}
 
-	return --uDivisionCount;
+	rWriter << "<svg xmlns=\"http://www.w3.org/2000/svg\"" <<
+		(uPrintFlags & Instanced ? " xmlns:xlink=\"http://www.w3.org/1999/xlink\"" : "") << " viewBox=\"" << sMinX << ' ' << sMinY << ' ' << sWidth << ' ' << sHeight << "\">" << rWriter.GetOptionalNewLine();
 }
@@ -1,18 +1,23 @@
 #ifndef __POLYHEDRON__
 #define __POLYHEDRON__
 
+#include <iostream>
+#include <memory>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "Defines.h"
 
+#include "FaceList.h"
+#include "MappedAllocator.h"
 #include "Polygon.h"
 #include "Vector3.h"
 
 // Forward Declarations
+class CPhiFractal;
 class CPhiPolyhedron;
+class CSvgWriter;
 
 class CPolyhedron {
 // Enums
@@ -25,40 +30,87 @@ public:
 		Depth				= 1 << 4,
 		Icosahedron			= 1 << 5,
 		Icosidodecahedron	= 1 << 6,
-		CullHiddenFaces		= 1 << 7
+		CullHiddenFaces		= 1 << 7,
+		Compact				= 1 << 8,	// Relative paths, rounded coordinates, and no optional whitespace
+		Instanced			= 1 << 9,	// Fractals define each level once and reuse it, unless colored, culled or depth-ordered
+		Batched				= 1 << 10	// Depth-ordered runs of same-colored elements share one path
+	};
+
+	// Per face side, in depth-ordered output, whether the face writes the side's edge and the side's first vertex
+	enum {
+		SideEdge	= 1 << 0,
+		SideVert	= 1 << 1
+	};
+
+	enum EPerspective {
+		AxisOrthogonal,
+		ThreeFoldSymmetry,
+		FiveFoldSymmetry
+	};
+
+// Structs
+public:
+	struct SFaceAttributes {
+		CVector3	m_vNormal;	// Unnormalized, pointing out of the face's polyhedral cell
+		CExtrema	m_Extrema;	// Of the face's projection onto the xy plane
+		f32			m_fDepth;	// Average z of the face's vertices
+		f32			m_fNormalZErrorBound;
+		u32			m_uAlpha;
 	};
 
 // Functions
 public:
 	CPolyhedron();
-	CPolyhedron(const CPhiPolyhedron& rPhiPolyhedron);
+	CPolyhedron(const CPhiPolyhedron& rPhiPolyhedron, EPerspective ePerspective = AxisOrthogonal);
+
+	CPolyhedron&	Focus3FoldSymmetry		();
+	CPolyhedron&	Focus5FoldSymmetry		();
+	bool			LoadGeometry			(const std::string& rFileName, u64 uKey);
+	void			PopulateFaceAttributes	(CMappedVector<SFaceAttributes>& rFaceAttributes)		const;
+	void			ProjectVertices			(const CPhiPolyhedron& rPhiPolyhedron, EPerspective ePerspective);
+	bool			SaveGeometry			(const std::string& rFileName, u64 uKey)				const;
+	bool			SaveTilesToSvg			(const std::string& rDirectoryName, u32 uLevelCount, u32 uPrintFlags = Verts | Faces, u32 uTileResolution = 256, u32 uSignificantDigits = 5)	const;
+	bool			SaveToSvg				(std::string fileName, u32 uPrintFlags = Verts | Faces, u32 uSignificantDigits = 5, s32 sCompressionLevel = 6)	const;
 
-	CPolyhedron&	Focus3FoldSymmetry	();
-	CPolyhedron&	Focus5FoldSymmetry	();
-	bool			SaveToSvg			(std::string fileName, u32 uPrintFlags = Verts | Faces)	const;
+	static	void	ComputeViewRotation	(EPerspective ePerspective, u32& ruRotatedAxis, f64& rdCos, f64& rdSin);
+	static	bool	SaveFractalToSvg	(const CPhiFractal& rPhiFractal, EPerspective ePerspective, std::string fileName, u32 uPrintFlags = Verts | Faces, const std::string& rCacheName = "", u32 uSignificantDigits = 5, s32 sCompressionLevel = 6);
 private:
-	bool		CompareFaceIndices		(u32 uIndexA, u32 uIndexB)														const;
-	u32			ComputeRGB				(u32 uPrintFlags, u32 uIndexType, u32 uIndex)									const;
-	u32			ComputeRGBA				(u32 uPrintFlags, u32 uFaceIndex)												const;
+	u32			ComputeRGB				(u32 uPrintFlags, u32 uIndexType, u64 uIndex)									const;
+	u32			ComputeRGBA				(u32 uPrintFlags, u32 uFaceIndex, u32 uAlpha)									const;
+	f32			ComputeFaceDepth		(u32 uFaceIndex)																const;
+	f32			ComputeNormalZErrorBound(u32 uFaceIndex)																const;
 	CVector3	GetFaceNormal			(u32 uFace, bool bShouldNormalize = false)										const;
 	CPolygon	GeneratePolygonForFace	(u32 uFaceIndex)																const;
-	void		PopulateInverseEdges	(std::unordered_map<u64, u32>& rInverseEdges)									const;
-	void		PopulateVisibleFaces	(const std::string& rFileName, const std::vector<u32>& rFaceIndices, std::unordered_set<u32>& rVisibleFaces)	const;
-	void		SortFaceIndicesByHeight	(std::vector<u32>& rFaceIndices)												const;
+	void		PopulateSideFlags		(const CMappedVector<u32>& rFaceIndices, const CMappedVector<u8>& rVisibleFaces, const CMappedVector<u32>& rSideEdges, CMappedVector<u8>& rSideFlags)	const;
+	void		PopulateVisibleFaces	(const std::string& rFileName, const CMappedVector<SFaceAttributes>& rFaceAttributes, const CMappedVector<u32>& rFaceIndices, CMappedVector<u8>& rVisibleFaces)	const;
+	void		SortFaceIndicesByHeight	(const CMappedVector<SFaceAttributes>& rFaceAttributes, CMappedVector<u32>& rFaceIndices)	const;
+	void		WriteDepthOrderedFace	(CSvgWriter& rWriter, u32 uPrintFlags, u32 uFaceIndex, u32 uAlpha, const u32* pSideEdges, const u8* pSideFlags)	const;
+	void		WriteFacePathData		(CSvgWriter& rWriter, u32 uFaceIndex, bool bShouldWindClockwise = false)						const;
+	void		WriteGroupedElements	(CSvgWriter& rWriter, u32 uPrintFlags, u32 uIndexType, const CMappedVector<SFaceAttributes>& rFaceAttributes)	const;
 	
-	static	u32			ComputeAlpha	(f32 dT, f32 dMinAlpha = 4.0, f32 dMaxAlpha = 64.0);
-	static	CVector3	ComputeNormal	(const CVector3& rVector0, const CVector3& rVector1, const CVector3& rVector2, bool bShouldNormalize = false);
-	static	u32			ComputeRGB		(u32 uColorLevel);
-	static	u32			ComputeU32Log	(u32 x, u32 uBase);
+	static	bool		SaveInstancedFractalToSvg	(const CPhiFractal& rPhiFractal, EPerspective ePerspective, std::string fileName, u32 uPrintFlags, u32 uSignificantDigits, s32 sCompressionLevel);
+	static	bool		CloseSvgFile		(CSvgWriter& rWriter, std::ostream& rFile);
+	static	u32			ComputeAlpha		(f32 dT, f32 dMinAlpha = 4.0, f32 dMaxAlpha = 64.0);
+	static	CVector3	ComputeNormal		(const CVector3& rVector0, const CVector3& rVector1, const CVector3& rVector2, bool bShouldNormalize = false);
+	static	u32			ComputeRGB			(u32 uColorLevel);
+	static	void		ComputeViewBox		(const CExtrema& rExtrema, s32& rsMinX, s32& rsMinY, s32& rsWidth, s32& rsHeight);
+	static	bool		IsBackFacing		(const SFaceAttributes& rFaceAttributes);
+	static	std::unique_ptr<std::ostream>	OpenSvgFile	(const std::string& rFileName, s32 sCompressionLevel);
+	static	void		WriteLinePathData	(CSvgWriter& rWriter, const CVector3& rStart, const CVector3& rEnd);
+	static	void		WriteSvgHeader		(CSvgWriter& rWriter, const CExtrema& rExtrema, u32 uPrintFlags, u32 uSignificantDigits);
 	#if DBG_PH
-	static	u32			GetMaskLevel	() { return sm_uMaskLevel; }
+	static	u32			GetMaskLevel		() { return sm_uMaskLevel; }
 	#endif // DBG_PH
 
 // Variables
 public:
-	std::vector<CVector3>				m_Vertices;
-	std::vector<std::pair<u32, u32>>	m_Edges;
-	std::vector<std::vector<u32>>		m_Faces;
+	CMappedVector<CVector3>				m_Vertices;
+	CMappedVector<std::pair<u32, u32>>	m_Edges;
+	CFaceList							m_Faces;
+	CMappedVector<f32>					m_VertexErrors;	// Bounds each coordinate's error vs. the exact vertex, if known
+	CMappedVector<u8>					m_VertexLevels;	// As in CPhiPolyhedron, or for one copy of a CPhiFractal's base
+	CMappedVector<u8>					m_EdgeLevels;
+	CMappedVector<u8>					m_FaceLevels;
 
 private:
 	#if DBG_PH
@@ -0,0 +1,82 @@
+#ifndef __RADIX_SORT__
+#define __RADIX_SORT__
+
+#include <array>
+#include <bit>
+#include <vector>
+
+#include "Defines.h"
+#include "Parallel.h"
+
+// Maps an f32 to a u32 such that unsigned integer ordering matches floating point ordering
+inline u32 computeSortableKey(f32 fKey) {
+	const u32 uBits = std::bit_cast<u32>(fKey);
+
+	return uBits ^ (uBits & 0x80000000u ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+// Stable LSD radix sort of rValues by rKeys (which are permuted alongside), one byte per pass. Passes where every key
+// shares the same byte are skipped, and for large inputs each pass is histogrammed and scattered in parallel chunks. The
+// arrays may use any allocator, which their scratch buffers then share.
+template<typename _KeyVector, typename _ValueVector>
+void radixSort(_KeyVector& rKeys, _ValueVector& rValues) {
+	constexpr u32 uRadixBits = 8;
+	constexpr u32 uRadix = 1 << uRadixBits;
+	typedef std::array<u64, uRadix> Histogram;
+
+	const u64 uCount = rKeys.size();
+	const u32 uChunkCount = computeChunkCount(uCount, 1 << 16);
+	_KeyVector keysBuffer(uCount);
+	_ValueVector valuesBuffer(uCount);
+	std::vector<Histogram> chunkOffsets(uChunkCount);
+
+	for (u32 uShift = 0; uShift < 32; uShift += uRadixBits) {
+		parallelForChunks(uChunkCount, [&](u32 uChunk) {
+			Histogram& rHistogram = chunkOffsets[uChunk];
+
+			rHistogram.fill(0);
+
+			for (u64 i = computeChunkBegin(uCount, uChunkCount, uChunk), uEnd = computeChunkBegin(uCount, uChunkCount, uChunk + 1); i < uEnd; ++i) {
+				++rHistogram[(rKeys[i] >> uShift) & (uRadix - 1)];
+			}
+		});
+
+		u64 uOffset = 0;
+		bool bIsPassTrivial = false;
+
+		// Convert the per-chunk counts into scatter offsets: digit-major, then chunk-major, which keeps the sort stable
+		for (u32 uDigit = 0; uDigit < uRadix; ++uDigit) {
+			u64 uDigitCount = 0;
+
+			for (u32 uChunk = 0; uChunk < uChunkCount; ++uChunk) {
+				const u64 uChunkDigitCount = chunkOffsets[uChunk][uDigit];
+
+				chunkOffsets[uChunk][uDigit] = uOffset + uDigitCount;
+				uDigitCount += uChunkDigitCount;
+			}
+
+			bIsPassTrivial |= uDigitCount == uCount;
+			uOffset += uDigitCount;
+		}
+
+		if (bIsPassTrivial) {
+			continue;
+		}
+
+		parallelForChunks(uChunkCount, [&](u32 uChunk) {
+			Histogram& rOffsets = chunkOffsets[uChunk];
+
+			for (u64 i = computeChunkBegin(uCount, uChunkCount, uChunk), uEnd = computeChunkBegin(uCount, uChunkCount, uChunk + 1); i < uEnd; ++i) {
+				const u64 uDestination = rOffsets[(rKeys[i] >> uShift) & (uRadix - 1)]++;
+
+				keysBuffer[uDestination] = rKeys[i];
+				valuesBuffer[uDestination] = rValues[i];
+			}
+		});
+
+		std::swap(rKeys, keysBuffer);
+		std::swap(rValues, valuesBuffer);
+	}
+}
+
+#endif // __RADIX_SORT__
\ No newline at end of file
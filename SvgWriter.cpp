@@ -0,0 +1,87 @@
+#include "SvgWriter.h"
+
+#include <string>
+
+CSvgWriter::CSvgWriter(std::ostream* pOStream, u64 uFlushSize) :
+	m_pOStream(pOStream),
+	m_Buffer(uFlushSize),
+	m_uSize(0),
+	m_bIsCompact(false),
+	m_uDecimalCount(0),
+	m_dGridScale(1.0),
+	m_bFollowsNumber(false),
+	m_bFollowsPoint(false),
+	m_uRunKey(u64_MAX) {}
+
+CSvgWriter::~CSvgWriter() {
+	Flush();
+}
+
+void CSvgWriter::Flush() {
+	if (m_pOStream && m_uSize) {
+		m_pOStream->write(m_Buffer.data(), m_uSize);
+		m_uSize = 0;
+	}
+}
+
+void CSvgWriter::CopyFormat(const CSvgWriter& rWriter) {
+	m_bIsCompact = rWriter.m_bIsCompact;
+	m_uDecimalCount = rWriter.m_uDecimalCount;
+	m_dGridScale = rWriter.m_dGridScale;
+}
+
+// The grid is fine enough to give an sExtent-wide image uSignificantDigits significant digits
+void CSvgWriter::SetCompact(u32 uSignificantDigits, s32 sExtent) {
+	const u32 uIntegerDigitCount = std::to_string(std::max(std::abs(sExtent), 1)).size();
+
+	m_bIsCompact = true;
+	m_uDecimalCount = std::min(uSignificantDigits > uIntegerDigitCount ? uSignificantDigits - uIntegerDigitCount : 0, 9u);
+	m_dGridScale = std::pow(10.0, m_uDecimalCount);
+}
+
+// Writes sQuanta grid points as a decimal, without trailing zeros or a leading zero before the point
+void CSvgWriter::WriteQuanta(s64 sQuanta) {
+	const bool bFollowsNumber = m_bFollowsNumber;
+	const bool bFollowsPoint = m_bFollowsPoint;
+	c8 acDigits[24];
+	const u64 uMagnitude = sQuanta < 0 ? -static_cast<u64>(sQuanta) : sQuanta;
+	c8* pDigitsEnd = std::to_chars(acDigits, acDigits + sizeof(acDigits), uMagnitude).ptr;
+	const u64 uDigitCount = pDigitsEnd - acDigits;
+	const u64 uIntegerDigitCount = uDigitCount > m_uDecimalCount ? uDigitCount - m_uDecimalCount : 0;
+	u64 uDecimalCount = m_uDecimalCount;
+
+	while (uDecimalCount && pDigitsEnd[-1] == '0' && pDigitsEnd - acDigits > static_cast<s64>(uIntegerDigitCount)) {
+		--pDigitsEnd;
+		--uDecimalCount;
+	}
+
+	const bool bHasPoint = uMagnitude && uDecimalCount;
+	c8* pBegin = Reserve(uDigitCount + m_uDecimalCount + 3);
+	c8* pEnd = pBegin;
+
+	if (bFollowsNumber && sQuanta >= 0 && !(bHasPoint && !uIntegerDigitCount && bFollowsPoint)) {
+		*pEnd++ = ' ';
+	}
+
+	if (sQuanta < 0) {
+		*pEnd++ = '-';
+	}
+
+	if (!uMagnitude) {
+		*pEnd++ = '0';
+	} else {
+		pEnd = std::copy(acDigits, acDigits + uIntegerDigitCount, pEnd);
+
+		if (bHasPoint) {
+			*pEnd++ = '.';
+
+			// Digits missing from the front of a short magnitude are leading zeros of the decimals
+			pEnd = std::fill_n(pEnd, m_uDecimalCount - (uDigitCount - uIntegerDigitCount), '0');
+			pEnd = std::copy(acDigits + uIntegerDigitCount, pDigitsEnd, pEnd);
+		}
+	}
+
+	m_uSize += pEnd - pBegin;
+	m_bFollowsNumber = true;
+	m_bFollowsPoint = bHasPoint;
+}
\ No newline at end of file
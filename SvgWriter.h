@@ -0,0 +1,213 @@
+#ifndef __SVG_WRITER__
+#define __SVG_WRITER__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#include "Defines.h"
+
+#include "MappedAllocator.h"
+
+// Every byte's two lowercase hex digits
+inline constexpr std::array<c8, 512> g_kacHexDigitPairs = [] {
+	std::array<c8, 512> hexDigitPairs = {};
+
+	for (u32 b = 0; b < 256; ++b) {
+		hexDigitPairs[2 * b] = "0123456789abcdef"[b >> 4];
+		hexDigitPairs[2 * b + 1] = "0123456789abcdef"[b & 0xF];
+	}
+
+	return hexDigitPairs;
+}();
+
+// Formats SVG text into a large reusable buffer, with std::to_chars for numbers and a table for hex digits, and hands it
+// to the stream in large writes. The text matches what an std::ostream set to std::fixed, std::setprecision(5) and
+// std::setfill('0') writes, with hex fields written as std::hex << std::setw(uWidth) would. Without a stream, the text
+// is kept, in storage that's mapped once it outgrows the heap.
+// Once compact, f32s are rounded to a fixed grid and written as the fewest characters that read back as the same grid
+// point, with separators left out wherever a number's sign or point already ends the one before it, and hex colors take
+// their 3 or 4 digit forms wherever those mean the same color.
+// A run is an element left open so that following elements with the same key can add their path data to it
+class CSvgWriter {
+// Structs
+public:
+	struct SHex {
+		u32	m_uValue;
+		u32	m_uWidth;	// The minimum digit count, padded with leading zeros
+	};
+
+// Functions
+public:
+	CSvgWriter(std::ostream* pOStream, u64 uFlushSize = 1 << 20);
+	~CSvgWriter();
+
+	CSvgWriter(const CSvgWriter&) = delete;
+	CSvgWriter& operator=(const CSvgWriter&) = delete;
+
+	void				Clear				()										{ m_uSize = 0; }
+	bool				ContinueRun			(u64 uRunKey);
+	void				CopyFormat			(const CSvgWriter& rWriter);
+	void				EndRun				();
+	void				Flush				();
+	const c8*			GetData				()								const { return m_Buffer.data(); }
+	std::string_view	GetOptionalNewLine	()								const { return m_bIsCompact ? "" : "\n"; }
+	u64					GetSize				()								const { return m_uSize; }
+	bool				IsCompact			()								const { return m_bIsCompact; }
+	s64					Quantize			(f32 f)							const { return std::llround(f * m_dGridScale); }
+	void				SetCompact			(u32 uSignificantDigits, s32 sExtent);
+	void				Write				(const c8* pData, u64 uByteCount);
+	void				WriteQuanta			(s64 sQuanta);
+
+	template<u64 _Size>
+	CSvgWriter&	operator<<	(const c8 (&rString)[_Size]);
+	CSvgWriter&	operator<<	(c8 c);
+	CSvgWriter&	operator<<	(f32 f);
+	CSvgWriter&	operator<<	(s32 s);
+	CSvgWriter&	operator<<	(SHex hex);
+	CSvgWriter&	operator<<	(std::string_view string);
+private:
+	c8*	Reserve	(u64 uByteCount);
+
+// Variables
+private:
+	std::ostream*		m_pOStream;
+	CMappedVector<c8>	m_Buffer;
+	u64					m_uSize;
+	bool				m_bIsCompact;
+	u32					m_uDecimalCount;	// Of the compact grid
+	f64					m_dGridScale;		// Grid points per unit
+	bool				m_bFollowsNumber;	// Whether the last thing written was a compact number
+	bool				m_bFollowsPoint;	// Whether that number had a decimal point
+	u64					m_uRunKey;			// Of the open run, or u64_MAX
+};
+
+inline CSvgWriter::SHex svgHex(u32 uValue, u32 uWidth) {
+	return { uValue, uWidth };
+}
+
+// Returns whether the open run has uRunKey. If not, it's ended, and the caller's next element starts a run with uRunKey
+inline bool CSvgWriter::ContinueRun(u64 uRunKey) {
+	if (m_uRunKey == uRunKey) {
+		return true;
+	}
+
+	EndRun();
+	m_uRunKey = uRunKey;
+
+	return false;
+}
+
+// Closes the open run's path data and element
+inline void CSvgWriter::EndRun() {
+	if (m_uRunKey != u64_MAX) {
+		m_uRunKey = u64_MAX;
+		*this << "\"/>" << GetOptionalNewLine();
+	}
+}
+
+inline void CSvgWriter::Write(const c8* pData, u64 uByteCount) {
+	std::memcpy(Reserve(uByteCount), pData, uByteCount);
+	m_uSize += uByteCount;
+}
+
+// The terminating null is left out
+template<u64 _Size>
+CSvgWriter& CSvgWriter::operator<<(const c8 (&rString)[_Size]) {
+	Write(rString, _Size - 1);
+
+	return *this;
+}
+
+inline CSvgWriter& CSvgWriter::operator<<(c8 c) {
+	*Reserve(1) = c;
+	++m_uSize;
+
+	return *this;
+}
+
+// Enough for any f32 with 5 decimals: 39 integer digits, a sign, a point and the decimals
+inline CSvgWriter& CSvgWriter::operator<<(f32 f) {
+	if (m_bIsCompact) {
+		WriteQuanta(Quantize(f));
+
+		return *this;
+	}
+
+	c8* pBegin = Reserve(64);
+
+	m_uSize += std::to_chars(pBegin, pBegin + 64, f, std::chars_format::fixed, 5).ptr - pBegin;
+
+	return *this;
+}
+
+inline CSvgWriter& CSvgWriter::operator<<(s32 s) {
+	c8* pBegin = Reserve(16);
+
+	m_uSize += std::to_chars(pBegin, pBegin + 16, s).ptr - pBegin;
+
+	return *this;
+}
+
+// Fills two digits per table lookup, from the least significant end
+inline CSvgWriter& CSvgWriter::operator<<(SHex hex) {
+	// #rrggbb(aa) is #rgb(a) when each byte's digits match
+	if (m_bIsCompact && (hex.m_uWidth == 6 || hex.m_uWidth == 8) && hex.m_uValue < 1ull << 4 * hex.m_uWidth &&
+		(hex.m_uValue >> 4 & 0x0F0F0F0F) == (hex.m_uValue & 0x0F0F0F0F)) {
+		u32 uShortValue = 0;
+
+		for (u32 b = 0; b < hex.m_uWidth / 2; ++b) {
+			uShortValue |= (hex.m_uValue >> 8 * b & 0xF) << 4 * b;
+		}
+
+		hex = { uShortValue, hex.m_uWidth / 2 };
+	}
+
+	const u32 uDigitCount = std::max<u32>(hex.m_uWidth, std::max<u32>((std::bit_width(hex.m_uValue) + 3) / 4, 1));
+	c8* pBegin = Reserve(uDigitCount);
+	c8* pEnd = pBegin + uDigitCount;
+	u32 uValue = hex.m_uValue;
+
+	for (; pEnd - pBegin >= 2; uValue >>= 8) {
+		pEnd -= 2;
+		std::memcpy(pEnd, &g_kacHexDigitPairs[2 * (uValue & 0xFF)], 2);
+	}
+
+	if (pEnd != pBegin) {
+		*pBegin = g_kacHexDigitPairs[2 * (uValue & 0xF) + 1];
+	}
+
+	m_uSize += uDigitCount;
+
+	return *this;
+}
+
+inline CSvgWriter& CSvgWriter::operator<<(std::string_view string) {
+	Write(string.data(), string.size());
+
+	return *this;
+}
+
+// Without a stream, the buffer grows instead of flushing
+inline c8* CSvgWriter::Reserve(u64 uByteCount) {
+	m_bFollowsNumber = false;
+
+	if (m_uSize + uByteCount > m_Buffer.size()) {
+		if (m_pOStream) {
+			Flush();
+		}
+
+		if (m_uSize + uByteCount > m_Buffer.size()) {
+			m_Buffer.resize(std::max<u64>(2 * m_Buffer.size(), m_uSize + uByteCount));
+		}
+	}
+
+	return m_Buffer.data() + m_uSize;
+}
+
+#endif // __SVG_WRITER__
\ No newline at end of file
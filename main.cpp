@@ -1,10 +1,23 @@
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+#include <cstdio>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numbers>
 #include <sstream>
 #include <string>
 
+#include <zlib.h>
+
+#include "FaceStream.h"
+#include "GeometryFile.h"
 #include "Logging.h"
+#include "Parallel.h"
+#include "PhiFractal.h"
 #include "PhiPolyhedron.h"
 #include "PhiVector.h"
 #include "PhiVector3.h"
@@ -12,22 +25,25 @@
 #include "Polyhedron.h"
 #include "Vector2.h"
 #include "Svg.h"
+#include "SvgWriter.h"
 
 using namespace NLog;
 
-void SavePolyhedronToSvg(u32 uPrintFlags, u32 uPolyhedron, u32 uPerspective, u32 uIteration) {
-	CPhiPolyhedron phiPolyhedron;
+// Given rCacheDirectory, the materialized geometry is cached there and reused by later calls, at tens of MB per file from
+// iteration 3 on
+void SavePolyhedronToSvg(u32 uPrintFlags, u32 uPolyhedron, u32 uPerspective, u32 uIteration, const std::string& rCacheDirectory = "") {
+	CPhiFractal phiFractal;
 	const char* pPolyhedronStr;
 	u32 uPolyhedronFlag = 0;
 
 	switch (uPolyhedron) {
 	case 0:
-		phiPolyhedron.GenerateIcosahedronFractal(uIteration);
+		phiFractal.GenerateIcosahedronFractal(uIteration);
 		pPolyhedronStr = "Icosahedron";
 		uPolyhedronFlag = CPolyhedron::Icosahedron;
 		break;
 	case 1:
-		phiPolyhedron.GenerateIcosidodecahedronFractal(uIteration);
+		phiFractal.GenerateIcosidodecahedronFractal(uIteration);
 		pPolyhedronStr = "Icosidodecahedron";
 		uPolyhedronFlag = CPolyhedron::Icosidodecahedron;
 		break;
@@ -35,19 +51,20 @@ void SavePolyhedronToSvg(u32 uPrintFlags, u32 uPolyhedron, u32 uPerspective, u32
 		return;
 	}
 
-	CPolyhedron polyhedron(phiPolyhedron);
+	CPolyhedron::EPerspective ePerspective;
 	const char* pPerspectiveStr;
 
 	switch (uPerspective) {
 	case 0:
+		ePerspective = CPolyhedron::AxisOrthogonal;
 		pPerspectiveStr = "AxisOrthogonal";
 		break;
 	case 1:
-		polyhedron.Focus3FoldSymmetry();
+		ePerspective = CPolyhedron::ThreeFoldSymmetry;
 		pPerspectiveStr = "3FoldSymmetry";
 		break;
 	case 2:
-		polyhedron.Focus5FoldSymmetry();
+		ePerspective = CPolyhedron::FiveFoldSymmetry;
 		pPerspectiveStr = "5FoldSymmetry";
 		break;
 	default:
@@ -63,7 +80,8 @@ void SavePolyhedronToSvg(u32 uPrintFlags, u32 uPolyhedron, u32 uPerspective, u32
 		'_' << uIteration <<
 		(uPrintFlags & CPolyhedron::CullHiddenFaces ? "_culled" : "") <<
 		".svg";
-	polyhedron.SaveToSvg(ss.str(), uPrintFlags | uPolyhedronFlag);
+	CPolyhedron::SaveFractalToSvg(phiFractal, ePerspective, ss.str(), uPrintFlags | uPolyhedronFlag,
+		rCacheDirectory.empty() ? "" : rCacheDirectory + '/' + pPolyhedronStr + '_' + std::to_string(uIteration));
 	std::cout << ss.str() << " saved\n";
 }
 
@@ -79,12 +97,13 @@ void SaveAllSvgs(
 	u32 uIterationCount = 4,
 	u32 uPolyhedronBegin = 0,
 	u32 uPerspectiveBegin = 0,
-	u32 uIterationBegin = 0) {
+	u32 uIterationBegin = 0,
+	const std::string& rCacheDirectory = "") {
 
 	for (u32 uPolyhedron = uPolyhedronBegin; uPolyhedron < uPolyhedronCount; ++uPolyhedron) {
 		for (u32 uPerspective = uPerspectiveBegin; uPerspective < uPerspectiveCount; ++uPerspective) {
 			for (u32 uIteration = uIterationBegin; uIteration < uIterationCount; ++uIteration) {
-				SavePolyhedronToSvg(uPrintFlags, uPolyhedron, uPerspective, uIteration);
+				SavePolyhedronToSvg(uPrintFlags, uPolyhedron, uPerspective, uIteration, rCacheDirectory);
 			}
 		}
 	}
@@ -92,7 +111,7 @@ void SaveAllSvgs(
 
 void PrintAllVertices() {
 	CPhiPolyhedron icosidodecahedron(CPhiPolyhedron::GetIcosidodecahedron());
-	const std::vector<CPhiVector3>& rVerts = icosidodecahedron.m_Vertices;
+	const CMappedVector<CPhiVector3>& rVerts = icosidodecahedron.m_Vertices;
 
 	for (u32 i = 0; i < rVerts.size(); ++i) {
 		std::cout << rVerts[i] << std::endl;
@@ -101,7 +120,7 @@ void PrintAllVertices() {
 
 void EvaluateIcosidodecahedronDistances() {
 	CPhiPolyhedron icosidodecahedron(CPhiPolyhedron::GetIcosidodecahedron());
-	const std::vector<CPhiVector3>& rVerts = icosidodecahedron.m_Vertices;
+	const CMappedVector<CPhiVector3>& rVerts = icosidodecahedron.m_Vertices;
 
 	for (u32 i = 0; i < rVerts.size(); ++i) {
 		for (u32 j = i + 1; j < rVerts.size(); ++j) {
@@ -163,6 +182,769 @@ void GeneratePotentiallyEquivalentCPhiVectors() {
 	}
 }
 
+s32 GenerateRandomCoefficient(u32 uBits) {
+	return static_cast<s32>(((static_cast<u64>(rand()) << 31) | rand()) & ((1ull << (uBits + 1)) - 1)) - (1 << uBits);
+}
+
+// A long double holds a + b * phi to within 2^-38 for |a|, |b| <= 2^24, while a nonzero a + b * phi is never closer to 0
+// than 1 / (sqrt(5) * 2^25), so the sign of the reference is exact in that range
+s32 ComputeReferencePhiVectorSign(s32 sA, s32 sB) {
+	const long double ldValue = sA + sB * std::numbers::phi_v<long double>;
+
+	return (ldValue > 0.0l) - (ldValue < 0.0l);
+}
+
+void TestPhiVectorOrdering(u32 uTrialCount = 1000000) {
+	u32 uExactFailureCount = 0;
+	u32 uFloatFailureCount = 0;
+
+	for (u32 uTrial = 0; uTrial < uTrialCount; ++uTrial) {
+		const CPhiVector phiVectorA(GenerateRandomCoefficient(23), GenerateRandomCoefficient(23));
+		const CPhiVector phiVectorB(GenerateRandomCoefficient(23), GenerateRandomCoefficient(23));
+		const s32 sReferenceSign = ComputeReferencePhiVectorSign(phiVectorA[0] - phiVectorB[0], phiVectorA[1] - phiVectorB[1]);
+
+		uExactFailureCount += (phiVectorA <=> phiVectorB) != (sReferenceSign <=> 0);
+		uFloatFailureCount += (static_cast<f32>(phiVectorA) <=> static_cast<f32>(phiVectorB)) != (sReferenceSign <=> 0);
+	}
+
+	// phi^-n = (-1)^n * (F(n + 1) - F(n) * phi), which is as close to 0 as coefficients of this size can get
+	s32 sFibPrev = 0;
+	s32 sFib = 1;
+
+	for (u32 n = 1; n < 46; ++n) {
+		const s32 sExpectedSign = n & 1 ? -1 : 1;
+		const CPhiVector phiVectorA(sFib + sFibPrev, 0);
+		const CPhiVector phiVectorB(0, sFib);
+
+		uExactFailureCount += (phiVectorA <=> phiVectorB) != (sExpectedSign <=> 0);
+		uExactFailureCount += CPhiVector(sFib + sFibPrev, -sFib).GetSign() != sExpectedSign;
+		uFloatFailureCount += (static_cast<f32>(phiVectorA) <=> static_cast<f32>(phiVectorB)) != (sExpectedSign <=> 0);
+		sFib += sFibPrev;
+		sFibPrev = sFib - sFibPrev;
+	}
+
+	std::cout << "Exact ordering failures: " << uExactFailureCount << '\n' <<
+		"Float ordering failures: " << uFloatFailureCount << '\n';
+}
+
+void BenchmarkPhiVectorOrdering(u32 uComparisonCount = 10000000) {
+	std::vector<CPhiVector> phiVectors;
+
+	for (u32 i = 0; i <= uComparisonCount; ++i) {
+		phiVectors.emplace_back(GenerateRandomCoefficient(30), GenerateRandomCoefficient(30));
+	}
+
+	const std::chrono::steady_clock::time_point exactStartTime = std::chrono::steady_clock::now();
+	u32 uExactLessCount = 0;
+
+	for (u32 i = 0; i < uComparisonCount; ++i) {
+		uExactLessCount += phiVectors[i] < phiVectors[i + 1];
+	}
+
+	const std::chrono::steady_clock::time_point floatStartTime = std::chrono::steady_clock::now();
+	u32 uFloatLessCount = 0;
+
+	for (u32 i = 0; i < uComparisonCount; ++i) {
+		uFloatLessCount += static_cast<f32>(phiVectors[i]) < static_cast<f32>(phiVectors[i + 1]);
+	}
+
+	const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+	std::cout << "Exact: " <<
+		std::chrono::duration<f64, std::nano>(floatStartTime - exactStartTime).count() / uComparisonCount << " ns/comparison (" <<
+		uExactLessCount << " less)\nFloat: " <<
+		std::chrono::duration<f64, std::nano>(endTime - floatStartTime).count() / uComparisonCount << " ns/comparison (" <<
+		uFloatLessCount << " less)\n";
+}
+
+// The coefficient-vector representation CPhiVector used before it was reduced to a + b * phi, kept as a reference
+struct SPhiPolynomial {
+	SPhiPolynomial(s32 sA, s32 sB) : m_Coefficients{sA, sB} {}
+
+	SPhiPolynomial operator+(const SPhiPolynomial& rPhiPolynomial) const {
+		SPhiPolynomial sum(*this);
+
+		sum.m_Coefficients.resize(std::max(m_Coefficients.size(), rPhiPolynomial.m_Coefficients.size()), 0);
+
+		for (u32 i = 0; i < rPhiPolynomial.m_Coefficients.size(); ++i) {
+			sum.m_Coefficients[i] += rPhiPolynomial.m_Coefficients[i];
+		}
+
+		return sum;
+	}
+
+	SPhiPolynomial operator*(const SPhiPolynomial& rPhiPolynomial) const {
+		SPhiPolynomial product(0, 0);
+
+		product.m_Coefficients.assign(m_Coefficients.size() + rPhiPolynomial.m_Coefficients.size() - 1, 0);
+
+		for (u32 i = 0; i < m_Coefficients.size(); ++i) {
+			for (u32 j = 0; j < rPhiPolynomial.m_Coefficients.size(); ++j) {
+				product.m_Coefficients[i + j] += m_Coefficients[i] * rPhiPolynomial.m_Coefficients[j];
+			}
+		}
+
+		return product;
+	}
+
+	f32 ToF32() const {
+		f32 fSum = 0.0f;
+		f32 fPower = 1.0f;
+
+		for (s64 sCoefficient : m_Coefficients) {
+			fSum += sCoefficient * fPower;
+			fPower *= std::numbers::phi_v<f32>;
+		}
+
+		return fSum;
+	}
+
+	// Reduces with phi^n = F(n - 1) + F(n) * phi
+	CPhiVector ToPhiVector() const {
+		s64 sA = 0;
+		s64 sB = 0;
+		s64 sFibPrev = 1;
+		s64 sFib = 0;
+
+		for (s64 sCoefficient : m_Coefficients) {
+			sA += sCoefficient * sFibPrev;
+			sB += sCoefficient * sFib;
+			sFib += sFibPrev;
+			sFibPrev = sFib - sFibPrev;
+		}
+
+		return CPhiVector(static_cast<s32>(sA), static_cast<s32>(sB));
+	}
+
+	std::vector<s64> m_Coefficients;
+};
+
+CPhiVector GenerateRandomPhiVector(u32 uBits) {
+	return CPhiVector(GenerateRandomCoefficient(uBits), GenerateRandomCoefficient(uBits));
+}
+
+CPhiVector3 GenerateRandomPhiVector3(u32 uBits) {
+	return CPhiVector3(GenerateRandomPhiVector(uBits), GenerateRandomPhiVector(uBits), GenerateRandomPhiVector(uBits));
+}
+
+void TestPhiArithmetic(u32 uTrialCount = 100000) {
+	const CPhiVector zero(0);
+	const CPhiVector one(1);
+	const CPhiVector phi(0, 1);
+	std::vector<std::pair<const char*, u32>> failureCounts = {
+		{"phi^2 = phi + 1", phi * phi != phi + one},
+		{"Additive identity", 0},
+		{"Additive inverse", 0},
+		{"Multiplicative identity", 0},
+		{"Commutativity", 0},
+		{"Associativity", 0},
+		{"Distributivity", 0},
+		{"Matches reference", 0},
+		{"Ordering antisymmetry", 0},
+		{"Ordering transitivity", 0},
+		{"Ordering translation invariance", 0},
+		{"Ordering matches sign and f64", 0},
+		{"Equal values hash equally", 0},
+		{"Cross product identities", 0}};
+
+	for (u32 uTrial = 0; uTrial < uTrialCount; ++uTrial) {
+		// 10-bit coefficients keep triple products well within s32
+		const CPhiVector a = GenerateRandomPhiVector(10);
+		const CPhiVector b = GenerateRandomPhiVector(10);
+		const CPhiVector c = GenerateRandomPhiVector(10);
+		const SPhiPolynomial referenceA(a[0], a[1]);
+		const SPhiPolynomial referenceB(b[0], b[1]);
+		const std::strong_ordering ab = a <=> b;
+		const std::strong_ordering bc = b <=> c;
+		u32 uProperty = 1;
+
+		failureCounts[uProperty++].second += a + zero != a;
+		failureCounts[uProperty++].second += a + -a != zero || a - b != a + -b;
+		failureCounts[uProperty++].second += a * one != a || a * 3 != a + a + a || 3 * a != a * 3;
+		failureCounts[uProperty++].second += a + b != b + a || a * b != b * a;
+		failureCounts[uProperty++].second += (a + b) + c != a + (b + c) || (a * b) * c != a * (b * c);
+		failureCounts[uProperty++].second += a * (b + c) != a * b + a * c;
+		failureCounts[uProperty++].second +=
+			(referenceA + referenceB).ToPhiVector() != a + b ||
+			(referenceA * referenceB * referenceA).ToPhiVector() != a * b * a ||
+			std::abs(referenceA.ToF32() - static_cast<f32>(a)) > 1e-6f * (1.0f + std::abs(a[0]) + 2.0f * std::abs(a[1]));
+		failureCounts[uProperty++].second += (b <=> a) != (0 <=> ab) || (ab == 0) != (a == b);
+		failureCounts[uProperty++].second += ab == bc && ab != 0 && (a <=> c) != ab;
+		failureCounts[uProperty++].second += (a + c <=> b + c) != ab || (a * phi <=> b * phi) != ab;
+		failureCounts[uProperty++].second +=
+			((a - b).GetSign() <=> 0) != ab ||
+			(std::abs((a - b).GetF64()) > (a - b).GetF64ErrorBound() && ((a - b).GetF64() <=> 0.0) != ab);
+		failureCounts[uProperty++].second +=
+			std::hash<CPhiVector>()(a) != std::hash<CPhiVector>()(SPhiPolynomial(a[0], a[1]).ToPhiVector()) ||
+			std::hash<CPhiVector>()(a * b) != std::hash<CPhiVector>()(b * a);
+
+		const CPhiVector3 u = GenerateRandomPhiVector3(6);
+		const CPhiVector3 v = GenerateRandomPhiVector3(6);
+		const CPhiVector3 cross = u.Cross(v);
+
+		failureCounts[uProperty++].second +=
+			cross != CPhiVector3(zero, zero, zero) - v.Cross(u) ||
+			cross.Dot(u) != zero ||
+			cross.Dot(v) != zero ||
+			u.Dot(u) != u.GetMagnitudeSquared() ||
+			std::hash<CPhiVector3>()(u + v) != std::hash<CPhiVector3>()(v + u);
+	}
+
+	for (const std::pair<const char*, u32>& rFailureCount : failureCounts) {
+		std::cout << std::setw(32) << std::setfill(' ') << std::left << rFailureCount.first << ": " << rFailureCount.second << " failures\n";
+	}
+}
+
+template<typename _Func>
+f64 MeasureNanosecondsPerOp(u32 uOpCount, const _Func& rFunc) {
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	rFunc();
+
+	return std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - startTime).count() / uOpCount;
+}
+
+void BenchmarkPhiArithmetic(u32 uOpCount = 1 << 22) {
+	std::cout << std::setfill(' ') << std::left << std::setw(19) << "ns/op" << std::right;
+
+	for (const char* pOpName : {"add", "mul", "cmp", "f32", "f64", "ref add", "ref mul", "ref f32"}) {
+		std::cout << std::setw(9) << pOpName;
+	}
+
+	std::cout << '\n' << std::fixed << std::setprecision(2);
+
+	for (u32 uBits : {3, 10, 14}) {
+		std::vector<CPhiVector> phiVectors;
+		std::vector<SPhiPolynomial> phiPolynomials;
+
+		for (u32 i = 0; i <= uOpCount; ++i) {
+			phiVectors.push_back(GenerateRandomPhiVector(uBits));
+			phiPolynomials.emplace_back(phiVectors.back()[0], phiVectors.back()[1]);
+		}
+
+		// Unsigned checksums wrap instead of overflowing
+		u32 uChecksum = 0;
+		f64 dSum = 0.0;
+		const f64 aTimes[] = {
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { uChecksum += (phiVectors[i] + phiVectors[i + 1])[1]; } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { uChecksum += (phiVectors[i] * phiVectors[i + 1])[1]; } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { uChecksum += phiVectors[i] < phiVectors[i + 1]; } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { dSum += static_cast<f32>(phiVectors[i]); } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { dSum += phiVectors[i].GetF64(); } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { uChecksum += (phiPolynomials[i] + phiPolynomials[i + 1]).m_Coefficients.back(); } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { uChecksum += (phiPolynomials[i] * phiPolynomials[i + 1]).m_Coefficients.back(); } }),
+			MeasureNanosecondsPerOp(uOpCount, [&]() {
+				for (u32 i = 0; i < uOpCount; ++i) { dSum += phiPolynomials[i].ToF32(); } })};
+
+		std::cout << std::setw(2) << uBits << "-bit coefficients";
+
+		for (f64 dTime : aTimes) {
+			std::cout << std::setw(9) << dTime;
+		}
+
+		// Printing the results keeps the loops from being optimized away
+		std::cout << "  (checksums " << uChecksum << ", " << dSum << ")\n";
+	}
+}
+
+u64 ComputePhiPolyhedronMemoryUsage(const CPhiPolyhedron& rPhiPolyhedron) {
+	return sizeof(rPhiPolyhedron) +
+		rPhiPolyhedron.m_Vertices.capacity() * sizeof(CPhiVector3) +
+		rPhiPolyhedron.m_Edges.capacity() * sizeof(std::pair<u32, u32>) +
+		rPhiPolyhedron.m_Faces.GetMemoryUsage() +
+		rPhiPolyhedron.m_VertexLevels.capacity() + rPhiPolyhedron.m_EdgeLevels.capacity() + rPhiPolyhedron.m_FaceLevels.capacity();
+}
+
+void TestPhiFractal(u32 uMaterializedIterationCount = 4, u32 uIterationCount = 6, u32 uRandomAccessCount = 100000) {
+	for (u32 uPolyhedron = 0; uPolyhedron < 2; ++uPolyhedron) {
+		for (u32 uIteration = 0; uIteration < uIterationCount; ++uIteration) {
+			CPhiFractal phiFractal;
+
+			if (uPolyhedron) {
+				phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+			} else {
+				phiFractal.GenerateIcosahedronFractal(uIteration);
+			}
+
+			std::cout << (uPolyhedron ? "Icosidodecahedron " : "Icosahedron ") << uIteration << ": " <<
+				phiFractal.GetVertexCount() << " vertices, " <<
+				phiFractal.GetEdgeCount() << " edges, " <<
+				phiFractal.GetFaceCount() << " faces, implicit " <<
+				phiFractal.GetMemoryUsage() << " B";
+
+			if (uIteration >= uMaterializedIterationCount) {
+				std::cout << '\n';
+
+				continue;
+			}
+
+			CPhiPolyhedron phiPolyhedron;
+
+			if (uPolyhedron) {
+				phiPolyhedron.GenerateIcosidodecahedronFractal(uIteration);
+			} else {
+				phiPolyhedron.GenerateIcosahedronFractal(uIteration);
+			}
+
+			const CPhiPolyhedron materializedPhiPolyhedron = phiFractal.Materialize();
+			u32 uFailureCount =
+				(materializedPhiPolyhedron.m_Vertices != phiPolyhedron.m_Vertices) +
+				(materializedPhiPolyhedron.m_Edges != phiPolyhedron.m_Edges) +
+				(materializedPhiPolyhedron.m_Faces != phiPolyhedron.m_Faces) +
+				(materializedPhiPolyhedron.m_VertexLevels != phiPolyhedron.m_VertexLevels) +
+				(materializedPhiPolyhedron.m_EdgeLevels != phiPolyhedron.m_EdgeLevels) +
+				(materializedPhiPolyhedron.m_FaceLevels != phiPolyhedron.m_FaceLevels);
+			const CPhiPolyhedron& rBase = phiFractal.GetBase();
+			std::vector<u64> face;
+			CMappedVector<u8> vertexLevels;
+			CMappedVector<u8> edgeLevels;
+			CMappedVector<u8> faceLevels;
+
+			for (u32 uTrial = 0; uTrial < uRandomAccessCount; ++uTrial) {
+				const u64 uVert = static_cast<u64>(rand()) % phiFractal.GetVertexCount();
+				const u64 uFace = static_cast<u64>(rand()) % phiFractal.GetFaceCount();
+				const std::pair<u64, u64> edge = phiFractal.GetEdge(static_cast<u64>(rand()) % phiFractal.GetEdgeCount());
+
+				phiFractal.GetFace(uFace, face);
+				uFailureCount += phiFractal.GetVertex(uVert) != phiPolyhedron.m_Vertices[uVert];
+				uFailureCount += !std::equal(face.begin(), face.end(), phiPolyhedron.m_Faces[uFace].begin(), phiPolyhedron.m_Faces[uFace].end());
+				uFailureCount += edge.first >= phiPolyhedron.m_Vertices.size() || edge.second >= phiPolyhedron.m_Vertices.size();
+
+				// Ranges starting and ending mid-copy exercise the odometer's initial state and carries
+				if (uTrial < 100) {
+					const u64 uEnd = std::min<u64>(uVert + 1000, phiFractal.GetVertexCount());
+
+					phiFractal.ForEachVertex([&](u64 uRangeVert, const CPhiVector3& rVertex) {
+						uFailureCount += rVertex != phiPolyhedron.m_Vertices[uRangeVert];
+					}, uVert, uEnd);
+
+					const u64 uCopy = uVert / rBase.m_Vertices.size();
+
+					phiFractal.PopulateCopyLevels(uCopy, vertexLevels, edgeLevels, faceLevels);
+					uFailureCount += !std::equal(vertexLevels.begin(), vertexLevels.end(), phiPolyhedron.m_VertexLevels.begin() + uCopy * rBase.m_Vertices.size());
+					uFailureCount += !std::equal(edgeLevels.begin(), edgeLevels.end(), phiPolyhedron.m_EdgeLevels.begin() + uCopy * rBase.m_Edges.size());
+					uFailureCount += !std::equal(faceLevels.begin(), faceLevels.end(), phiPolyhedron.m_FaceLevels.begin() + uCopy * rBase.m_Faces.size());
+				}
+			}
+
+			std::cout << ", materialized " << ComputePhiPolyhedronMemoryUsage(phiPolyhedron) << " B, " << uFailureCount << " failures\n";
+		}
+	}
+}
+
+bool AreFilesEqual(const std::string& rFileNameA, const std::string& rFileNameB) {
+	std::ifstream fileA(rFileNameA, std::ios_base::binary);
+	std::ifstream fileB(rFileNameB, std::ios_base::binary);
+
+	return fileA && fileB && std::equal(
+		std::istreambuf_iterator<char>(fileA), std::istreambuf_iterator<char>(),
+		std::istreambuf_iterator<char>(fileB), std::istreambuf_iterator<char>());
+}
+
+// Streams each fractal's faces in both directions, and checks the streamed SVG against the materialized one
+void TestFaceStream(u32 uIterationCount = 4) {
+	const u32 uPrintFlags = CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth;
+
+	for (u32 uPolyhedron = 0; uPolyhedron < 2; ++uPolyhedron) {
+		for (u32 uIteration = 0; uIteration < uIterationCount; ++uIteration) {
+			CPhiFractal phiFractal;
+
+			if (uPolyhedron) {
+				phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+			} else {
+				phiFractal.GenerateIcosahedronFractal(uIteration);
+			}
+
+			const u32 uPolyhedronFlag = uPolyhedron ? CPolyhedron::Icosidodecahedron : CPolyhedron::Icosahedron;
+			const CPolyhedron::EPerspective ePerspective = CPolyhedron::FiveFoldSymmetry;
+			CFaceStream backToFront(phiFractal, ePerspective);
+			CFaceStream frontToBack(phiFractal, ePerspective, true);
+			CFaceStream::SFace face;
+			u64 uFaceCount = 0;
+			u32 uOrderFailureCount = 0;
+			f32 fPrevDepth = -FLT_MAX;
+
+			while (backToFront.Next(face)) {
+				uOrderFailureCount += face.m_pAttributes->m_fDepth < fPrevDepth;
+				fPrevDepth = face.m_pAttributes->m_fDepth;
+				++uFaceCount;
+			}
+
+			while (frontToBack.Next(face)) {
+				uOrderFailureCount += face.m_pAttributes->m_fDepth > fPrevDepth;
+				fPrevDepth = face.m_pAttributes->m_fDepth;
+				--uFaceCount;
+			}
+
+			const std::chrono::steady_clock::time_point streamedStartTime = std::chrono::steady_clock::now();
+
+			CPolyhedron::SaveFractalToSvg(phiFractal, ePerspective, "streamed.svg", uPrintFlags | uPolyhedronFlag);
+
+			const std::chrono::steady_clock::time_point materializedStartTime = std::chrono::steady_clock::now();
+
+			CPolyhedron(phiFractal.Materialize(), ePerspective).SaveToSvg("materialized.svg", uPrintFlags | uPolyhedronFlag);
+
+			const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+			std::cout << (uPolyhedron ? "Icosidodecahedron " : "Icosahedron ") << uIteration << ": " <<
+				phiFractal.GetFaceCount() << " faces, at most " <<
+				backToFront.GetSlotCount() << " copies (of " << phiFractal.GetCopyCount() << ") held, " <<
+				uOrderFailureCount << " order failures, " <<
+				(uFaceCount ? "directions disagree, " : "") <<
+				(AreFilesEqual("streamed.svg", "materialized.svg") ? "SVGs match" : "SVGs differ") << " (streamed " <<
+				std::chrono::duration<f64>(materializedStartTime - streamedStartTime).count() << " s, materialized " <<
+				std::chrono::duration<f64>(endTime - materializedStartTime).count() << " s)\n";
+		}
+	}
+
+	std::remove("streamed.svg");
+	std::remove("materialized.svg");
+}
+
+// Times generating each fractal's projected geometry against loading it back from a geometry file, and checks that the
+// loaded geometry matches and that corrupted or stale files are rejected
+void TestGeometryCache(u32 uIterationCount = 4) {
+	const char* pFileName = "geometry.poly";
+	const auto areEqual = [](const auto& rVectorA, const auto& rVectorB) {
+		return std::ranges::equal(CGeometryFile::GetBytes(rVectorA), CGeometryFile::GetBytes(rVectorB));
+	};
+
+	for (u32 uPolyhedron = 0; uPolyhedron < 2; ++uPolyhedron) {
+		for (u32 uIteration = 0; uIteration < uIterationCount; ++uIteration) {
+			CPhiFractal phiFractal;
+
+			if (uPolyhedron) {
+				phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+			} else {
+				phiFractal.GenerateIcosahedronFractal(uIteration);
+			}
+
+			const u64 uKey = phiFractal.ComputeKey();
+			const std::chrono::steady_clock::time_point generateStartTime = std::chrono::steady_clock::now();
+			const CPolyhedron generatedPolyhedron(phiFractal.Materialize(), CPolyhedron::FiveFoldSymmetry);
+			const std::chrono::steady_clock::time_point saveStartTime = std::chrono::steady_clock::now();
+
+			generatedPolyhedron.SaveGeometry(pFileName, uKey);
+
+			const std::chrono::steady_clock::time_point loadStartTime = std::chrono::steady_clock::now();
+			CPolyhedron loadedPolyhedron;
+			const bool bWasLoaded = loadedPolyhedron.LoadGeometry(pFileName, uKey);
+			const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+			const u32 uMismatchCount = !bWasLoaded +
+				!areEqual(loadedPolyhedron.m_Vertices, generatedPolyhedron.m_Vertices) +
+				!areEqual(loadedPolyhedron.m_Edges, generatedPolyhedron.m_Edges) +
+				(loadedPolyhedron.m_Faces != generatedPolyhedron.m_Faces) +
+				!areEqual(loadedPolyhedron.m_VertexErrors, generatedPolyhedron.m_VertexErrors) +
+				!areEqual(loadedPolyhedron.m_VertexLevels, generatedPolyhedron.m_VertexLevels) +
+				!areEqual(loadedPolyhedron.m_EdgeLevels, generatedPolyhedron.m_EdgeLevels) +
+				!areEqual(loadedPolyhedron.m_FaceLevels, generatedPolyhedron.m_FaceLevels);
+			const u64 uFileSize = std::filesystem::file_size(pFileName);
+			const bool bWasStaleKeyRejected = !loadedPolyhedron.LoadGeometry(pFileName, uKey + 1);
+
+			// Flip one bit in the middle of the arrays
+			{
+				std::fstream file(pFileName, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+				char cByte;
+
+				file.seekg(uFileSize / 2);
+				file.get(cByte);
+				file.seekp(uFileSize / 2);
+				file.put(cByte ^ 1);
+			}
+
+			const bool bWasCorruptionRejected = !loadedPolyhedron.LoadGeometry(pFileName, uKey);
+
+			std::cout << (uPolyhedron ? "Icosidodecahedron " : "Icosahedron ") << uIteration << ": " <<
+				uFileSize << " B, generated " <<
+				std::chrono::duration<f64>(saveStartTime - generateStartTime).count() << " s, saved " <<
+				std::chrono::duration<f64>(loadStartTime - saveStartTime).count() << " s, loaded " <<
+				std::chrono::duration<f64>(endTime - loadStartTime).count() << " s, " <<
+				uMismatchCount << " mismatches, stale key " << (bWasStaleKeyRejected ? "rejected" : "accepted") <<
+				", corruption " << (bWasCorruptionRejected ? "rejected" : "accepted") << '\n';
+		}
+	}
+
+	std::remove(pFileName);
+}
+
+// Formats the same face paths as WriteDepthOrderedFace() does, once through a std::ostream and its manipulators and once
+// through a CSvgWriter, checks that the text matches, and prints each one's throughput
+void BenchmarkSvgWriter(u32 uIteration = 3, u32 uRepeatCount = 4) {
+	CPhiFractal phiFractal;
+
+	phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+
+	const CPolyhedron polyhedron(phiFractal.Materialize(), CPolyhedron::FiveFoldSymmetry);
+	const auto measureMegabytesPerSecond = [uRepeatCount](const auto& rWrite, std::string& rText) {
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (u32 r = 0; r < uRepeatCount; ++r) {
+			std::ostringstream svg;
+
+			rWrite(svg);
+			rText = std::move(svg).str();
+		}
+
+		return uRepeatCount * rText.size() / std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+	};
+	std::string streamText;
+	std::string writerText;
+	const f64 dStreamRate = measureMegabytesPerSecond([&polyhedron](std::ostream& rOStream) {
+		rOStream << std::fixed << std::setprecision(5) << std::setfill('0');
+
+		for (u64 f = 0; f < polyhedron.m_Faces.size(); ++f) {
+			const std::span<const u32> face = polyhedron.m_Faces[f];
+
+			rOStream << "<path fill=\"#" << std::hex << std::setw(6) << (f & 0xFFFFFF) << std::dec << "\" d=\"M " <<
+				polyhedron.m_Vertices[face[0]].x << ' ' << polyhedron.m_Vertices[face[0]].y;
+
+			for (u32 fv = 1; fv < face.size(); ++fv) {
+				rOStream << " L " << polyhedron.m_Vertices[face[fv]].x << ' ' << polyhedron.m_Vertices[face[fv]].y;
+			}
+
+			rOStream << " Z\"/>\n";
+		}
+	}, streamText);
+	const f64 dWriterRate = measureMegabytesPerSecond([&polyhedron](std::ostream& rOStream) {
+		CSvgWriter writer(&rOStream);
+
+		for (u64 f = 0; f < polyhedron.m_Faces.size(); ++f) {
+			const std::span<const u32> face = polyhedron.m_Faces[f];
+
+			writer << "<path fill=\"#" << svgHex(f & 0xFFFFFF, 6) << "\" d=\"M " <<
+				polyhedron.m_Vertices[face[0]].x << ' ' << polyhedron.m_Vertices[face[0]].y;
+
+			for (u32 fv = 1; fv < face.size(); ++fv) {
+				writer << " L " << polyhedron.m_Vertices[face[fv]].x << ' ' << polyhedron.m_Vertices[face[fv]].y;
+			}
+
+			writer << " Z\"/>\n";
+		}
+	}, writerText);
+
+	std::cout << std::fixed << std::setprecision(1) << streamText.size() << " B of faces: std::ostream " << dStreamRate <<
+		" MB/s, CSvgWriter " << dWriterRate << " MB/s, text " << (streamText == writerText ? "matches" : "differs") << '\n';
+}
+
+// Saves the same fractal verbosely and then compactly at each significant digit count, and prints each file's size and
+// write time
+void BenchmarkCompactSvg(u32 uIteration = 2, u32 uPrintFlags = CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth) {
+	const char* pFileName = "compact.svg";
+	CPhiFractal phiFractal;
+
+	phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+
+	for (u32 uSignificantDigits : {0, 3, 4, 5, 6}) {
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		CPolyhedron::SaveFractalToSvg(phiFractal, CPolyhedron::FiveFoldSymmetry, pFileName,
+			uPrintFlags | (uSignificantDigits ? CPolyhedron::Compact : 0), "", uSignificantDigits);
+
+		const f64 dSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+		if (uSignificantDigits) {
+			std::cout << "Compact, " << uSignificantDigits << " digits: ";
+		} else {
+			std::cout << "Verbose: ";
+		}
+
+		std::cout << std::filesystem::file_size(pFileName) << " B, written in " << dSeconds << " s\n";
+	}
+
+	std::remove(pFileName);
+}
+
+// Saves each fractal explicitly and then instanced, grouped by element type as instancing requires, and prints each
+// file's size and write time
+void BenchmarkInstancedSvg(u32 uIterationCount = 4, u32 uPrintFlags = CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces) {
+	const char* pFileName = "instanced.svg";
+
+	for (u32 uIteration = 0; uIteration < uIterationCount; ++uIteration) {
+		CPhiFractal phiFractal;
+
+		phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+		std::cout << "Icosidodecahedron " << uIteration << ':';
+
+		for (u32 uInstancedFlag : { 0u, static_cast<u32>(CPolyhedron::Instanced) }) {
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			CPolyhedron::SaveFractalToSvg(phiFractal, CPolyhedron::FiveFoldSymmetry, pFileName, uPrintFlags | uInstancedFlag);
+
+			std::cout << (uInstancedFlag ? " instanced " : " explicit ") << std::filesystem::file_size(pFileName) << " B in " <<
+				std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count() << " s";
+		}
+
+		std::cout << '\n';
+	}
+
+	std::remove(pFileName);
+}
+
+// Saves each depth-ordered rendering unbatched and then batched, and prints each file's element count, size and write time
+void BenchmarkBatchedSvg(u32 uIteration = 2) {
+	const char* pFileName = "batched.svg";
+	CPhiFractal phiFractal;
+
+	phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+
+	for (u32 uPrintFlags : {
+		CPolyhedron::Faces | CPolyhedron::Depth,
+		CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth,
+		CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Depth,
+		CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth }) {
+		std::cout << (uPrintFlags & CPolyhedron::Verts ? "Faces, edges and vertices" : "Faces") << (uPrintFlags & CPolyhedron::Color ? ", colored:" : ":");
+
+		for (u32 uBatchedFlag : { 0u, static_cast<u32>(CPolyhedron::Batched) }) {
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			CPolyhedron::SaveFractalToSvg(phiFractal, CPolyhedron::FiveFoldSymmetry, pFileName, uPrintFlags | uBatchedFlag | CPolyhedron::Icosidodecahedron);
+
+			const f64 dSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+			std::ifstream file(pFileName);
+			const u64 uElementCount = std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '<') / 2;
+
+			std::cout << (uBatchedFlag ? " batched " : " unbatched ") << uElementCount << " elements, " << std::filesystem::file_size(pFileName) <<
+				" B in " << dSeconds << " s";
+		}
+
+		std::cout << '\n';
+	}
+
+	std::remove(pFileName);
+}
+
+// Saves the same fractal as .svg and then as .svgz at each compression level, checks that each .svgz inflates to the
+// .svg's text, and prints each file's size and write time, and the rate at which SVG text was written
+void BenchmarkSvgz(u32 uIteration = 2, u32 uPrintFlags = CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth) {
+	const char* pFileName = "deflated.svg";
+	const std::string deflatedFileName = std::string(pFileName) + 'z';
+	CPhiFractal phiFractal;
+	std::string text;
+
+	phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+
+	for (s32 sCompressionLevel : { -2, 1, 6, 9 }) {
+		const bool bIsDeflated = sCompressionLevel >= 0;
+		const std::string fileName = bIsDeflated ? deflatedFileName : pFileName;
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		CPolyhedron::SaveFractalToSvg(phiFractal, CPolyhedron::FiveFoldSymmetry, fileName, uPrintFlags | CPolyhedron::Icosidodecahedron, "", 5,
+			sCompressionLevel);
+
+		const f64 dSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+		if (bIsDeflated) {
+			gzFile pFile = gzopen(fileName.c_str(), "rb");
+			std::string inflatedText(text.size() + 1, '\0');
+			const s32 sInflatedSize = pFile ? gzread(pFile, inflatedText.data(), inflatedText.size()) : -1;
+
+			if (pFile) {
+				gzclose(pFile);
+			}
+
+			inflatedText.resize(std::max(sInflatedSize, 0));
+			std::cout << "Level " << sCompressionLevel << ": ";
+
+			if (inflatedText != text) {
+				std::cout << "inflated text differs, ";
+			}
+		} else {
+			std::ifstream file(fileName);
+
+			text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			std::cout << "Uncompressed: ";
+		}
+
+		std::cout << std::filesystem::file_size(fileName) << " B, written in " << dSeconds << " s, " << text.size() / dSeconds * 1e-6 <<
+			" MB/s of SVG\n";
+	}
+
+	std::remove(pFileName);
+	std::remove(deflatedFileName.c_str());
+}
+
+// Saves a fractal as one SVG and then as a tile pyramid, and prints the file's size and write time, then each level's
+// tile count, total and largest tile size, and the pyramid's write time
+void BenchmarkTiledSvg(u32 uIteration = 2, u32 uLevelCount = 6, u32 uPrintFlags = CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth) {
+	const char* pFileName = "tiled.svg";
+	const char* pDirectoryName = "tiles";
+	CPhiFractal phiFractal;
+
+	phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+
+	const CPolyhedron polyhedron(phiFractal.Materialize(), CPolyhedron::FiveFoldSymmetry);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	polyhedron.SaveToSvg(pFileName, uPrintFlags | CPolyhedron::Icosidodecahedron);
+	std::cout << "Whole: " << std::filesystem::file_size(pFileName) << " B in " <<
+		std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count() << " s\n";
+	startTime = std::chrono::steady_clock::now();
+
+	const bool bWasSaved = polyhedron.SaveTilesToSvg(pDirectoryName, uLevelCount, uPrintFlags | CPolyhedron::Icosidodecahedron);
+
+	std::cout << "Tiled: " << (bWasSaved ? "saved" : "failed") << " in " <<
+		std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count() << " s\n";
+
+	for (u32 uLevel = 0; uLevel < uLevelCount; ++uLevel) {
+		u64 uTileCount = 0;
+		u64 uTotalSize = 0;
+		u64 uMaxSize = 0;
+
+		for (const std::filesystem::directory_entry& rEntry : std::filesystem::directory_iterator(std::string(pDirectoryName) + '/' + std::to_string(uLevel))) {
+			++uTileCount;
+			uTotalSize += rEntry.file_size();
+			uMaxSize = std::max<u64>(uMaxSize, rEntry.file_size());
+		}
+
+		std::cout << "Level " << uLevel << ": " << uTileCount << " tiles, " << uTotalSize << " B, largest " << uMaxSize << " B\n";
+	}
+
+	std::remove(pFileName);
+	std::filesystem::remove_all(pDirectoryName);
+}
+
+// Saves a depth-ordered rendering with its faces formatted on one thread and then on every hardware thread, and prints
+// each file's size, best write time of uRepeatCount, and the speedup
+void BenchmarkParallelSvg(u32 uIteration = 3, u32 uRepeatCount = 3, u32 uPrintFlags = CPolyhedron::Verts | CPolyhedron::Edges | CPolyhedron::Faces | CPolyhedron::Color | CPolyhedron::Depth) {
+	const char* pFileName = "parallel.svg";
+	CPhiFractal phiFractal;
+
+	phiFractal.GenerateIcosidodecahedronFractal(uIteration);
+
+	const CPolyhedron polyhedron(phiFractal.Materialize(), CPolyhedron::FiveFoldSymmetry);
+	f64 dSingleThreadSeconds = 0.0;
+
+	for (u32 uThreadCount : { 1u, std::max(std::thread::hardware_concurrency(), 1u) }) {
+		f64 dBestSeconds = DBL_MAX;
+
+		g_uThreadCount = uThreadCount;
+
+		for (u32 uRepeat = 0; uRepeat < uRepeatCount; ++uRepeat) {
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			polyhedron.SaveToSvg(pFileName, uPrintFlags | CPolyhedron::Icosidodecahedron);
+			dBestSeconds = std::min(dBestSeconds, std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count());
+		}
+
+		if (uThreadCount == 1) {
+			dSingleThreadSeconds = dBestSeconds;
+		}
+
+		std::cout << uThreadCount << (uThreadCount == 1 ? " thread: " : " threads: ") << std::filesystem::file_size(pFileName) << " B in " <<
+			dBestSeconds << " s, " << dSingleThreadSeconds / dBestSeconds << "x\n";
+	}
+
+	g_uThreadCount = 0;
+	std::remove(pFileName);
+}
+
 void TestPolygonUnion(s32 sFirstIndex = -1, s32 sLastIndex = -1) {
 	if (sLastIndex == -1) {
 		sLastIndex = sFirstIndex;
@@ -1068,6 +1850,20 @@ s32 main(s32 sArgCount, char* aArgValues[]) {
 		0, 0, 3);
 
 	// TestPolygonUnion(sArgCount, aArgValues);
+	// TestPhiVectorOrdering();
+	// BenchmarkPhiVectorOrdering();
+	// TestPhiArithmetic();
+	// BenchmarkPhiArithmetic();
+	// TestPhiFractal();
+	// TestFaceStream();
+	// TestGeometryCache();
+	// BenchmarkSvgWriter();
+	// BenchmarkCompactSvg();
+	// BenchmarkInstancedSvg();
+	// BenchmarkBatchedSvg();
+	// BenchmarkSvgz();
+	// BenchmarkTiledSvg();
+	// BenchmarkParallelSvg();
 
 	return 0;
 }